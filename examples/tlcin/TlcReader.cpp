@@ -29,6 +29,7 @@ bool TlcReader::parseFile(const std::filesystem::path& filePath,
 {
     ctrl_ = ctrl;
     cellNames_.clear();
+    layers_.clear();
 
     // Create a top-level cell and parse the file
     ctrl_->openCell(filePath.string(), true);
@@ -77,7 +78,7 @@ void TlcReader::parseCell(const fs::path& filePath, const fs::path& parentPath)
                     int layerNumber;
                     file >> layerName >> layerNumber >> std::ws;
 
-                    ctrl_->selectLayer(layerNumber);
+                    selectLayer(layerNumber);
                     ctrl_->setLayerComment(layerName);
                 }
                 break;
@@ -173,7 +174,7 @@ void TlcReader::parseCell(const fs::path& filePath, const fs::path& parentPath)
                 file >> layer >> bottomLeft.x >> bottomLeft.y >> topRight.x >> topRight.y >>
                     std::ws;
 
-                ctrl_->selectLayer(layer);
+                selectLayer(layer);
                 ctrl_->createRectangle(scale(bottomLeft, scaling), scale(topRight, scaling));
                 break;
             }
@@ -184,7 +185,7 @@ void TlcReader::parseCell(const fs::path& filePath, const fs::path& parentPath)
                 long width, vertexCount;
                 file >> layer >> width >> vertexCount >> std::ws;
 
-                ctrl_->selectLayer(layer);
+                selectLayer(layer);
 
                 // Read vertices
                 PointArray vertices;
@@ -219,7 +220,7 @@ void TlcReader::parseCell(const fs::path& filePath, const fs::path& parentPath)
                 unsigned long orientFlags;
                 file >> layer >> height >> vertexCount >> orientFlags >> std::ws;
 
-                ctrl_->selectLayer(layer);
+                selectLayer(layer);
 
                 // Read reference point
                 Point position;
@@ -282,11 +283,28 @@ Point TlcReader::scale(const Point& pt, double scaling) const
 }
 
 //------------------------------------------------------------------------------
-bool TlcReader::isIncluded(const std::string& name)
+bool TlcReader::isIncluded(std::string_view name)
 {
-    // Try to insert the name. If it already exists, insert returns false
-    // for the second element of the pair, indicating it was already included
-    return !cellNames_.insert(name).second;
+    // Look up without building a string; only new names are copied
+    if (cellNames_.find(name) != cellNames_.end())
+        return true;
+
+    cellNames_.emplace(name);
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void TlcReader::selectLayer(int layerNumber)
+{
+    auto [it, inserted] = layers_.try_emplace(layerNumber, nullptr);
+    if (inserted)
+    {
+        it->second = ctrl_->selectLayer(layerNumber);
+    }
+    else
+    {
+        ctrl_->selectLayer(it->second);
+    }
 }
 
 }  // namespace lc::format::tlcin
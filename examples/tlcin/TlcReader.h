@@ -8,9 +8,11 @@
 #pragma once
 
 #include <lc/plugin/IReaderImpl.h>
-#include <set>
 #include <string>
+#include <string_view>
 #include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace lc::format::tlcin {
 
@@ -42,14 +44,30 @@ private:
     void parseCell(const std::filesystem::path& filePath, const std::filesystem::path& parentPath);
 
     // Check if cell has already been included
-    bool isIncluded(const std::string& name);
+    bool isIncluded(std::string_view name);
+
+    // Select a layer by number, resolving each number only once
+    void selectLayer(int layerNumber);
 
     // Scale and round a point
     Point scale(const Point& pt, double scaling) const;
 
 private:
+    // Hash supporting heterogeneous lookup by std::string_view
+    struct NameHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    using NameSet = std::unordered_set<std::string, NameHash, std::equal_to<>>;
+
     plugin::IDrawingBuilder* ctrl_ = nullptr;  // drawing builder interface
-    std::set<std::string> cellNames_;  // track included cell names to avoid duplicates
+    NameSet cellNames_;  // track included cell names to avoid duplicates
+    std::unordered_map<int, db::Layer*> layers_;  // layers resolved by number
 };
 
 }  // namespace lc::format::tlcin
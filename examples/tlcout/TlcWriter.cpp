@@ -29,6 +29,8 @@ bool TlcWriter::writeFile(const std::filesystem::path& /*filePath*/,
 
         cellName_ = conv::Properties::exportCellName(ctrl_->drawing());
         layerNumber_ = conv::Properties::exportLayerNumber(ctrl_->drawing());
+        layerNumbers_.clear();
+        cellNames_.clear();
 
         // Create directory
         auto outputDir = ctrl_->fileName();
@@ -67,7 +69,7 @@ bool TlcWriter::writeFile(const std::filesystem::path& /*filePath*/,
 //------------------------------------------------------------------------------
 bool TlcWriter::writeCell(const db::Cell* cell)
 {
-    auto cellFileName = fs::path(ctrl_->fileName()) / cell->propget(cellName_);
+    auto cellFileName = fs::path(ctrl_->fileName()) / cellName(cell);
     cellFileName.replace_extension("tlc");
 
     os_.open(cellFileName, std::ios::binary);
@@ -151,20 +153,19 @@ bool TlcWriter::writeEntity(const db::Polygon* poly, geom::FillRule /*fillRule*/
 {
     if (!poly->isBox())
     {
-        PointArray vertices;
-        poly->vertices(vertices,
+        poly->vertices(vertices_,
                        db::VertexMode::RemoveDuplicates | db::VertexMode::ForceDuplicateEnd);
 
         os_ << "=P\n"
-            << poly->layer()->propget(layerNumber_) << " " << 0 << " " << vertices.size() << "\n";
+            << layerNumber(poly->layer()) << " " << 0 << " " << vertices_.size() << "\n";
 
-        for (size_t i = 0; i < vertices.size(); ++i)
+        for (size_t i = 0; i < vertices_.size(); ++i)
         {
-            auto pt = scale(vertices[i]);
+            auto pt = scale(vertices_[i]);
             os_ << pt.x << " " << pt.y << " ";
 
             // split in groups of five vertices per line
-            if (i != 0 && i < vertices.size() - 1 && (i + 1) % 5 == 0)
+            if (i != 0 && i < vertices_.size() - 1 && (i + 1) % 5 == 0)
             {
                 os_ << "\n";
             }
@@ -178,7 +179,7 @@ bool TlcWriter::writeEntity(const db::Polygon* poly, geom::FillRule /*fillRule*/
         auto pt1 = scale(bounds.maxXY());
 
         os_ << "=B\n"
-            << poly->layer()->propget(layerNumber_) << " " << pt0.x << " " << pt0.y << " " << pt1.x
+            << layerNumber(poly->layer()) << " " << pt0.x << " " << pt0.y << " " << pt1.x
             << " " << pt1.y << "\n";
     }
 
@@ -188,20 +189,20 @@ bool TlcWriter::writeEntity(const db::Polygon* poly, geom::FillRule /*fillRule*/
 //------------------------------------------------------------------------------
 bool TlcWriter::writeEntity(const db::Polyline* pline)
 {
-    PointArray vertices;
-    pline->vertices(vertices, db::VertexMode::RemoveDuplicates | db::VertexMode::ForceDuplicateEnd);
+    pline->vertices(vertices_,
+                    db::VertexMode::RemoveDuplicates | db::VertexMode::ForceDuplicateEnd);
 
     os_ << "=P\n"
-        << pline->layer()->propget(layerNumber_) << " " << scale(pline->width()) << " "
-        << vertices.size() << "\n";
+        << layerNumber(pline->layer()) << " " << scale(pline->width()) << " "
+        << vertices_.size() << "\n";
 
-    for (size_t i = 0; i < vertices.size(); ++i)
+    for (size_t i = 0; i < vertices_.size(); ++i)
     {
-        auto pt = scale(vertices[i]);
+        auto pt = scale(vertices_[i]);
         os_ << pt.x << " " << pt.y << " ";
 
         // split in groups of five vertices per line
-        if (i != 0 && i < vertices.size() - 1 && (i + 1) % 5 == 0)
+        if (i != 0 && i < vertices_.size() - 1 && (i + 1) % 5 == 0)
         {
             os_ << "\n";
         }
@@ -214,27 +215,25 @@ bool TlcWriter::writeEntity(const db::Polyline* pline)
 //------------------------------------------------------------------------------
 bool TlcWriter::writeEntity(const db::Ref* ref, const db::Layer* /*layer*/)
 {
-    auto cellName = ref->refCell()->propget(cellName_);
+    const auto& name = cellName(ref->refCell());
     const auto xform = ref->transformation();
 
     if (fmod(xform.rotation().degrees(), 90.0) != 0.0)
     {
-        ctrl_->log()->log(
-            env::Severity::Warning,
-            std::format("Ignored non-90 degree rotation in reference '{}'.", cellName));
+        ctrl_->log()->log(env::Severity::Warning,
+                          std::format("Ignored non-90 degree rotation in reference '{}'.", name));
     }
 
     if (xform.isRotationAbsolute())
     {
         ctrl_->log()->log(env::Severity::Warning,
-                          std::format("Ignored absolute rotation in reference '{}'.", cellName));
+                          std::format("Ignored absolute rotation in reference '{}'.", name));
     }
 
     if (xform.isScalingAbsolute())
     {
-        ctrl_->log()->log(
-            env::Severity::Warning,
-            std::format("Ignored absolute magnification in reference '{}'.", cellName));
+        ctrl_->log()->log(env::Severity::Warning,
+                          std::format("Ignored absolute magnification in reference '{}'.", name));
     }
 
     for (auto col = 0u; col < ref->columns(); ++col)
@@ -246,7 +245,7 @@ bool TlcWriter::writeEntity(const db::Ref* ref, const db::Layer* /*layer*/)
             transform.canonicalize();
 
             os_ << "=C\n";
-            os_ << std::filesystem::path(cellName).stem() << "\n";
+            os_ << std::filesystem::path(name).stem() << "\n";
 
             auto orientation = (static_cast<int>(xform.rotation().degrees()) + 45) / 90;
 
@@ -263,6 +262,30 @@ bool TlcWriter::writeEntity(const db::Ref* ref, const db::Layer* /*layer*/)
     return true;
 }
 
+//------------------------------------------------------------------------------
+int TlcWriter::layerNumber(const db::Layer* layer)
+{
+    auto [it, inserted] = layerNumbers_.try_emplace(layer, 0);
+    if (inserted)
+    {
+        it->second = layer->propget(layerNumber_);
+    }
+
+    return it->second;
+}
+
+//------------------------------------------------------------------------------
+const std::string& TlcWriter::cellName(const db::Cell* cell)
+{
+    auto [it, inserted] = cellNames_.try_emplace(cell);
+    if (inserted)
+    {
+        it->second = cell->propget(cellName_);
+    }
+
+    return it->second;
+}
+
 //------------------------------------------------------------------------------
 Point TlcWriter::scale(const Point& pt) const
 {
@@ -10,6 +10,8 @@
 #include <lc/plugin/IWriterImpl.h>
 #include <lc/conv/Properties.h>
 #include <fstream>
+#include <string>
+#include <unordered_map>
 
 namespace lc::format::tlcout {
 
@@ -47,6 +49,12 @@ private:
     // Write a complete cell
     bool writeCell(const db::Cell* cell);
 
+    // Get export layer number, resolving the property only once per layer
+    int layerNumber(const db::Layer* layer);
+
+    // Get export cell name, resolving the property only once per cell
+    const std::string& cellName(const db::Cell* cell);
+
     // Scale a point from internal units to TLC units
     [[nodiscard]] Point scale(const Point& pt) const;
 
@@ -59,6 +67,9 @@ private:
     int scaling_ = 1;  // scaling factor
     conv::Properties::ExportCellName* cellName_ = nullptr;  // cell naming property
     conv::Properties::ExportLayerNumber* layerNumber_ = nullptr;  // layer numbering property
+    PointArray vertices_;  // vertex buffer, reused across entities to avoid reallocation
+    std::unordered_map<const db::Layer*, int> layerNumbers_;  // resolved layer numbers
+    std::unordered_map<const db::Cell*, std::string> cellNames_;  // resolved cell names
 };
 
 }  // namespace lc::format::tlcout
@@ -0,0 +1,245 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Drawing.h"
+#include "Cell.h"
+#include "Ref.h"
+#include <lc/geom/PointHash.h>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace lc::db {
+
+//! Replace regular lattices of single references by array references
+//!
+//! References in the cell are grouped by referenced cell, layer and
+//! transformation (except translation). Within each group, the translations
+//! are searched for regular 1D and 2D lattices, which are then replaced by a
+//! single array reference: the reference at the lattice origin is turned into
+//! an array using setColumns(), setRows(), setColumnSpacing() and
+//! setRowSpacing(), and the other references of the lattice are destroyed.
+//!
+//! Lattices are searched in the coordinate system of the references, such
+//! that arrays of rotated or mirrored references are found as well. Only
+//! references rotated by multiples of 90 degrees and not scaled are
+//! considered, as only these map array positions to coordinates exactly.
+//!
+//! The drawing must be write-locked by the caller.
+//!
+//! \param cell         Cell
+//! \param minInstances Minimum number of references per array
+//! \return             Number of references removed
+size_t recognizeArrayRefs(Cell* cell, unsigned int minInstances = 4);
+
+//! Replace regular lattices of single references by array references in all cells
+//!
+//! See: recognizeArrayRefs(Cell*, unsigned int)
+size_t recognizeArrayRefs(Drawing* dwg, unsigned int minInstances = 4);
+
+//! Replace regular lattices among the given references by array references
+//!
+//! Like recognizeArrayRefs(Cell*, unsigned int), but only the given
+//! references (e.g. those created by a previous operation) are considered.
+//! The references must belong to the same cell.
+//!
+//! \param refs         References
+//! \param minInstances Minimum number of references per array
+//! \return             Number of references removed
+size_t recognizeArrayRefs(const std::vector<Ref*>& refs, unsigned int minInstances = 4);
+
+namespace detail {
+
+// Array reference candidate
+struct ArrayRefCandidate
+{
+    Ref* ref;
+    Point pos;  // translation in coordinate system of reference
+};
+
+// Find lattices in group of references with identical cell, layer and
+// transformation (except translation)
+inline size_t findArrayRefs(std::vector<ArrayRefCandidate>& group, unsigned int minInstances)
+{
+    // process from bottom left to top right, such that each unassigned
+    // reference is the origin of a potential array
+    std::sort(group.begin(), group.end(), [](auto&& a, auto&& b) {
+        return a.pos.y != b.pos.y ? a.pos.y < b.pos.y : a.pos.x < b.pos.x;
+    });
+
+    // unassigned references by position
+    std::unordered_map<Point, Ref*, geom::PointHash> unassigned;
+    unassigned.reserve(group.size());
+    for (auto&& candidate : group)
+    {
+        unassigned.emplace(candidate.pos, candidate.ref);
+    }
+
+    // sorted coordinates of all references by row and by column
+    std::unordered_map<coord, std::vector<coord>> rows, columns;
+    for (auto&& candidate : group)
+    {
+        rows[candidate.pos.y].push_back(candidate.pos.x);
+        columns[candidate.pos.x].push_back(candidate.pos.y);
+    }
+
+    // get distance to next coordinate in sorted list, or 0 if none
+    auto nextDistance = [](const std::vector<coord>& values, coord value) -> dist {
+        auto it = std::upper_bound(values.begin(), values.end(), value);
+        return it != values.end() ? *it - value : 0;
+    };
+
+    size_t removed = 0;
+    std::vector<Ref*> lattice;
+
+    for (auto&& [origin, pos] : group)
+    {
+        if (!unassigned.contains(pos))
+            continue;
+
+        auto isUnassigned = [&](coord x, coord y) { return unassigned.contains(Point(x, y)); };
+
+        // extent along the row
+        dist dx = nextDistance(rows[pos.y], pos.x);
+        unsigned int cols = 1;
+        while (dx > 0 && isUnassigned(pos.x + cols * dx, pos.y))
+        {
+            ++cols;
+        }
+
+        // extent along the column, requiring complete rows
+        dist dy = nextDistance(columns[pos.x], pos.y);
+        unsigned int rowCount = 1;
+        while (dy > 0)
+        {
+            bool complete = true;
+            for (unsigned int i = 0; i < cols && complete; ++i)
+            {
+                complete = isUnassigned(pos.x + i * dx, pos.y + rowCount * dy);
+            }
+
+            if (!complete)
+                break;
+
+            ++rowCount;
+        }
+
+        if (cols * rowCount < std::max(minInstances, 2u))
+        {
+            unassigned.erase(pos);
+            continue;
+        }
+
+        lattice.clear();
+        for (unsigned int j = 0; j < rowCount; ++j)
+        {
+            for (unsigned int i = 0; i < cols; ++i)
+            {
+                auto it = unassigned.find(Point(pos.x + i * dx, pos.y + j * dy));
+                if (it->second != origin)
+                    lattice.push_back(it->second);
+
+                unassigned.erase(it);
+            }
+        }
+
+        origin->setColumns(cols);
+        origin->setRows(rowCount);
+        origin->setColumnSpacing(cols > 1 ? dx : 0);
+        origin->setRowSpacing(rowCount > 1 ? dy : 0);
+
+        for (auto ref : lattice)
+        {
+            ref->destroy();
+        }
+
+        removed += lattice.size();
+    }
+
+    return removed;
+}
+
+}  // namespace detail
+
+//------------------------------------------------------------------------------
+inline size_t recognizeArrayRefs(Cell* cell, unsigned int minInstances /* = 4 */)
+{
+    auto cellRefs = cell->cellObjects<Ref>();
+    return recognizeArrayRefs(std::vector<Ref*>(cellRefs.begin(), cellRefs.end()), minInstances);
+}
+
+//------------------------------------------------------------------------------
+inline size_t recognizeArrayRefs(const std::vector<Ref*>& refs,
+                                 unsigned int minInstances /* = 4 */)
+{
+    struct Group
+    {
+        const Cell* refCell;
+        const Layer* layer;
+        Xform xform;  // transformation without translation
+        std::vector<detail::ArrayRefCandidate> candidates;
+    };
+
+    std::vector<Group> groups;
+    std::unordered_map<const Cell*, std::vector<size_t>> groupsByCell;
+
+    for (auto ref : refs)
+    {
+        if (!ref->refCell() || ref->columns() != 1 || ref->rows() != 1)
+            continue;
+
+        auto xform = ref->transformation();
+        auto degrees = xform.rotation().degrees();
+        if (xform.isScaled() || std::abs(degrees - 90.0 * std::round(degrees / 90.0)) > 1e-9)
+            continue;
+
+        auto translation = xform.translation();
+        xform.setTranslation(Vector(0, 0));
+
+        auto& indices = groupsByCell[ref->refCell()];
+        auto it = std::find_if(indices.begin(), indices.end(), [&](size_t index) {
+            return groups[index].layer == ref->layer() && groups[index].xform == xform;
+        });
+
+        if (it == indices.end())
+        {
+            indices.push_back(groups.size());
+            groups.push_back({ref->refCell(), ref->layer(), xform, {}});
+            it = indices.end() - 1;
+        }
+
+        // array spacing applies before the transformation
+        auto pos = xform.reverseTransformPoint(Point(translation.x, translation.y));
+        groups[*it].candidates.push_back({ref, pos});
+    }
+
+    size_t removed = 0;
+    for (auto&& group : groups)
+    {
+        if (group.candidates.size() >= std::max(minInstances, 2u))
+            removed += detail::findArrayRefs(group.candidates, minInstances);
+    }
+
+    return removed;
+}
+
+//------------------------------------------------------------------------------
+inline size_t recognizeArrayRefs(Drawing* dwg, unsigned int minInstances /* = 4 */)
+{
+    size_t removed = 0;
+    for (auto cell : dwg->cells())
+    {
+        removed += recognizeArrayRefs(cell, minInstances);
+    }
+
+    return removed;
+}
+
+}  // namespace lc::db
@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "dbtypes.h"
+#include <lc/geom/PointHash.h>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace lc::db::detail {
+
+// Disjoint set forest
+class DisjointSets
+{
+public:
+    explicit DisjointSets(size_t count)
+        : parent_(count)
+    {
+        std::iota(parent_.begin(), parent_.end(), size_t{0});
+    }
+
+    size_t find(size_t i)
+    {
+        while (parent_[i] != i)
+        {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+
+        return i;
+    }
+
+    void unite(size_t a, size_t b) { parent_[find(a)] = find(b); }
+
+private:
+    std::vector<size_t> parent_;
+};
+
+// Invoke callback(i, j) once for each pair of items with overlapping or
+// touching bounds
+//
+// Items are entered into a grid of twice the median item extent, and only
+// items sharing a grid cell are compared. Items covering many grid cells
+// (e.g. planes) are either skipped (joinLarge = false), or compared against
+// all other items (joinLarge = true).
+template <typename F>
+void forEachOverlappingPair(const std::vector<Bounds>& bounds, bool joinLarge, F&& callback)
+{
+    constexpr dist maxGridCellsPerItem = 64;
+
+    if (bounds.empty())
+        return;
+
+    // grid size of twice the median extent, such that most items occupy few
+    // grid cells
+    std::vector<dist> extents;
+    extents.reserve(bounds.size());
+    for (auto&& b : bounds)
+    {
+        extents.push_back(std::max(b.width(), b.height()));
+    }
+
+    std::nth_element(extents.begin(), extents.begin() + extents.size() / 2, extents.end());
+    const dist gridSize = std::max<dist>(2 * extents[extents.size() / 2], 1);
+
+    auto gridIndex = [gridSize](coord c) {
+        return c >= 0 ? c / gridSize : -((-c + gridSize - 1) / gridSize);
+    };
+
+    std::unordered_map<Point, std::vector<size_t>, geom::PointHash> grid;
+    std::vector<size_t> large;
+    std::vector<bool> isLarge(bounds.size());
+
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+        auto x0 = gridIndex(bounds[i].minXY().x), x1 = gridIndex(bounds[i].maxXY().x);
+        auto y0 = gridIndex(bounds[i].minXY().y), y1 = gridIndex(bounds[i].maxXY().y);
+
+        if ((x1 - x0 + 1) * (y1 - y0 + 1) > maxGridCellsPerItem)
+        {
+            if (joinLarge)
+                large.push_back(i);
+
+            isLarge[i] = true;
+            continue;
+        }
+
+        for (auto x = x0; x <= x1; ++x)
+        {
+            for (auto y = y0; y <= y1; ++y)
+            {
+                auto& entries = grid[Point(x, y)];
+                for (auto j : entries)
+                {
+                    // report pair only in the grid cell containing the lower
+                    // left corner of the overlap
+                    if (bounds[i].overlaps(bounds[j]) &&
+                        x == std::max(x0, gridIndex(bounds[j].minXY().x)) &&
+                        y == std::max(y0, gridIndex(bounds[j].minXY().y)))
+                        callback(i, j);
+                }
+
+                entries.push_back(i);
+            }
+        }
+    }
+
+    for (auto i : large)
+    {
+        for (size_t j = 0; j < bounds.size(); ++j)
+        {
+            if (j != i && (!isLarge[j] || j < i) && bounds[i].overlaps(bounds[j]))
+                callback(i, j);
+        }
+    }
+}
+
+// Cluster items with overlapping or touching bounds
+//
+// See forEachOverlappingPair() for the treatment of large items, which remain
+// clusters of their own unless joinLarge is set.
+inline std::vector<std::vector<size_t>> clusterBounds(const std::vector<Bounds>& bounds,
+                                                      bool joinLarge)
+{
+    DisjointSets sets(bounds.size());
+    forEachOverlappingPair(bounds, joinLarge, [&](size_t i, size_t j) { sets.unite(i, j); });
+
+    std::unordered_map<size_t, size_t> clusterIndex;
+    std::vector<std::vector<size_t>> clusters;
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+        auto [it, inserted] = clusterIndex.try_emplace(sets.find(i), clusters.size());
+        if (inserted)
+            clusters.emplace_back();
+
+        clusters[it->second].push_back(i);
+    }
+
+    return clusters;
+}
+
+}  // namespace lc::db::detail
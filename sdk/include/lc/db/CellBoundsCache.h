@@ -0,0 +1,323 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Drawing.h"
+#include "Cell.h"
+#include "Ref.h"
+#include "IDrawingEventListener.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace lc::db {
+
+//! Cache for Cell::bounds(), maintained incrementally through drawing events
+//!
+//! Bounds are cached per (cell, layer) and computed lazily on first access.
+//! The bounds of a cell are composed of the bounds of its own shapes and the
+//! cached bounds of its child cells, transformed by each reference (including
+//! array extents), so that every cell is only evaluated once. The bounding box
+//! of a child cell rotated by an angle other than a multiple of 90 degrees is
+//! larger than the bounds of its rotated shapes; cells containing such
+//! references are therefore evaluated by Cell::bounds(). Either way, the
+//! cached bounds equal those returned by Cell::bounds().
+//!
+//! Whenever a cell object is added, modified or destroyed, the cached bounds of
+//! its owning cell and of all cells (directly or indirectly) referencing that
+//! cell are invalidated.
+//!
+//! Use like this:
+//!
+//!     CellBoundsCache cache(dwg);
+//!     cache.precompute();  // optional, e.g. right after import
+//!     auto bounds = cache.bounds(cell, layer);
+class CellBoundsCache final : public IDrawingEventListener
+{
+public:
+    //! Constructor, registers the cache as listener with the drawing
+    explicit CellBoundsCache(Drawing* dwg);
+
+    //! Destructor, unregisters the cache
+    ~CellBoundsCache() override;
+
+    CellBoundsCache(const CellBoundsCache&) = delete;
+    CellBoundsCache& operator=(const CellBoundsCache&) = delete;
+
+    //! Get bounding box of shapes in cell and sub-cells (see Cell::bounds())
+    //!
+    //! \param cell     Cell
+    //! \param layer    Restrict to shapes on this layer; all layers if nullptr
+    //! \return         Cached or freshly computed bounds
+    Bounds bounds(const Cell* cell, const Layer* layer = nullptr);
+
+    //! Compute bounds of all cells of the drawing, bottom-up
+    //!
+    //! Cells are processed by increasing number of child levels, such that the
+    //! bounds of child cells are cached when evaluating their parents. The
+    //! drawing must be locked by the caller.
+    //!
+    //! \param layers   Layers for which to compute bounds (nullptr: all layers)
+    void precompute(const std::vector<const Layer*>& layers = {nullptr});
+
+    //! Invalidate cached bounds of cell and of all cells referencing it
+    void invalidate(const Cell* cell);
+
+    //! Discard all cached bounds
+    void clear();
+
+protected:
+    // IDrawingEventListener
+    void onMainCellChanged(Drawing* drawing, Cell* oldCell) override;
+    void onObjectAdded(Drawing* drawing, Object* object) override;
+    void onObjectModified(Drawing* drawing, Object* object) override;
+    void onObjectDestroy(Drawing* drawing, const Object* object) override;
+
+private:
+    using LayerBounds = std::vector<std::pair<const Layer*, Bounds>>;
+
+    // Compute bounds of cell from its shapes and the bounds of its child cells
+    Bounds compute(const Cell* cell, const Layer* layer);
+
+    // Invalidate cache entries affected by change of object
+    void invalidateFor(const Object* object, bool destroyed);
+
+    // Invalidate cell and its ancestors (lock must be held)
+    void invalidateUp(const Cell* cell, std::unordered_set<const Cell*>& visited);
+
+    // Store bounds (lock must be held)
+    void store(const Cell* cell, const Layer* layer, const Bounds& bounds);
+
+private:
+    Drawing* dwg_;
+    std::mutex mutex_;
+    std::atomic<size_t> generation_ = 0;  // incremented on every invalidation
+    std::unordered_map<const Cell*, LayerBounds> cache_;
+};
+
+//------------------------------------------------------------------------------
+inline CellBoundsCache::CellBoundsCache(Drawing* dwg)
+    : dwg_(dwg)
+{
+    dwg_->addListener(this);
+}
+
+//------------------------------------------------------------------------------
+inline CellBoundsCache::~CellBoundsCache()
+{
+    dwg_->removeListener(this);
+}
+
+//------------------------------------------------------------------------------
+inline Bounds CellBoundsCache::bounds(const Cell* cell, const Layer* layer /* = nullptr */)
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        if (auto it = cache_.find(cell); it != cache_.end())
+        {
+            for (auto&& [cachedLayer, cachedBounds] : it->second)
+            {
+                if (cachedLayer == layer)
+                    return cachedBounds;
+            }
+        }
+    }
+
+    // compute outside of lock, as child cells may have to be evaluated first
+    size_t generation = generation_;
+    auto result = compute(cell, layer);
+
+    // don't store result if cache was invalidated in the meantime
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (generation == generation_)
+        store(cell, layer, result);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::precompute(const std::vector<const Layer*>& layers /* = {nullptr} */)
+{
+    // group cells by child levels
+    std::map<unsigned int, std::vector<const Cell*>> levels;
+    for (auto cell : dwg_->cells())
+    {
+        levels[cell->childLevels()].push_back(cell);
+    }
+
+    // evaluate leaf cells first, such that child bounds are cached; the
+    // drawing is only accessed from the calling thread, which holds the lock
+    for (auto&& [level, cells] : levels)
+    {
+        for (auto cell : cells)
+        {
+            for (auto layer : layers)
+            {
+                bounds(cell, layer);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+inline Bounds CellBoundsCache::compute(const Cell* cell, const Layer* layer)
+{
+    Bounds result;
+
+    for (auto obj : cell->cellObjects<CellObject>())
+    {
+        if (obj->dynamicType() != ObjectType::Ref)
+        {
+            if (!layer || obj->layer() == layer)
+                result.expandWith(obj->bounds());
+
+            continue;
+        }
+
+        auto ref = static_cast<const Ref*>(obj);
+        auto refCell = ref->refCell();
+        if (!refCell)
+            continue;
+
+        // transformed child bounds are only exact for multiples of 90 degrees
+        const auto xform = ref->transformation();
+        const auto angle = xform.rotation();
+        if (xform.isRotated() && !angle.equals(geom::Angle::piHalf) &&
+            !angle.equals(geom::Angle::pi) && !angle.equals(geom::Angle::threePiHalf))
+            return cell->bounds(layer);
+
+        auto childBounds = bounds(refCell, layer);
+        if (childBounds.empty())
+            continue;
+
+        // the transformation applies to the entire array
+        if (ref->columns() > 1 || ref->rows() > 1)
+        {
+            auto lastElement = childBounds;
+            lastElement.translate((std::max(ref->columns(), 1u) - 1) * ref->columnSpacing(),
+                                  (std::max(ref->rows(), 1u) - 1) * ref->rowSpacing());
+            childBounds.expandWith(lastElement);
+        }
+
+        result.expandWith(xform.transformBounds(childBounds));
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::invalidate(const Cell* cell)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    ++generation_;
+
+    if (cache_.empty())
+        return;
+
+    std::unordered_set<const Cell*> visited;
+    invalidateUp(cell, visited);
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::clear()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    ++generation_;
+    cache_.clear();
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::onMainCellChanged(Drawing* /*drawing*/, Cell* /*oldCell*/) {}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::onObjectAdded(Drawing* /*drawing*/, Object* object)
+{
+    invalidateFor(object, false);
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::onObjectModified(Drawing* /*drawing*/, Object* object)
+{
+    invalidateFor(object, false);
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::onObjectDestroy(Drawing* /*drawing*/, const Object* object)
+{
+    invalidateFor(object, true);
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::invalidateFor(const Object* object, bool destroyed)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    ++generation_;
+
+    if (cache_.empty())
+        return;
+
+    auto type = object->dynamicType();
+    std::unordered_set<const Cell*> visited;
+
+    if (isCellObject(type))
+    {
+        if (auto cell = static_cast<const CellObject*>(object)->owningCell())
+            invalidateUp(cell, visited);
+    }
+    else if (type == ObjectType::Cell)
+    {
+        invalidateUp(static_cast<const Cell*>(object), visited);
+    }
+    else if (type == ObjectType::Layer && destroyed)
+    {
+        for (auto&& [cell, entries] : cache_)
+        {
+            std::erase_if(entries, [object](auto&& entry) { return entry.first == object; });
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::invalidateUp(const Cell* cell,
+                                          std::unordered_set<const Cell*>& visited)
+{
+    if (!visited.insert(cell).second)
+        return;
+
+    cache_.erase(cell);
+
+    for (auto ref : cell->cellRefs())
+    {
+        if (auto parent = ref->owningCell())
+            invalidateUp(parent, visited);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void CellBoundsCache::store(const Cell* cell, const Layer* layer, const Bounds& bounds)
+{
+    auto& entries = cache_[cell];
+
+    for (auto&& entry : entries)
+    {
+        if (entry.first == layer)
+        {
+            entry.second = bounds;
+            return;
+        }
+    }
+
+    entries.emplace_back(layer, bounds);
+}
+
+}  // namespace lc::db
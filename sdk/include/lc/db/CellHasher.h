@@ -0,0 +1,321 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Drawing.h"
+#include "Cell.h"
+#include "Ref.h"
+#include "Shape.h"
+#include <lc/geom/PointHash.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace lc::db {
+
+// hashing primitives (see lc/geom/PointHash.h)
+using geom::hashCombine;
+using geom::hashMix;
+using geom::PointHash;
+
+//! Compute hash of shape consistent with Shape::equivalentTo()
+//!
+//! The hash covers the shape type, layer and bounding box only, such that
+//! shapes differing only in orientation (sense) or starting vertex hash
+//! identically. Use Shape::equivalentTo() to confirm matches.
+inline uint64_t shapeHash(const Shape* shape)
+{
+    const auto bounds = shape->bounds();
+
+    auto h = hashMix(static_cast<uint64_t>(shape->dynamicType()));
+    h = hashCombine(h, reinterpret_cast<uintptr_t>(shape->layer()));
+    h = hashCombine(h, static_cast<uint64_t>(bounds.minXY().x));
+    h = hashCombine(h, static_cast<uint64_t>(bounds.minXY().y));
+    h = hashCombine(h, static_cast<uint64_t>(bounds.maxXY().x));
+    h = hashCombine(h, static_cast<uint64_t>(bounds.maxXY().y));
+    return h;
+}
+
+//! Content hash of cells
+//!
+//! The hash of a cell is computed from its shapes (see shapeHash()) and
+//! references, independent of the order of its cell objects and of its name.
+//! References contribute the content hash of the referenced cell rather than
+//! its identity, so that cells referencing identical (but distinct) child cells
+//! hash identically.
+//!
+//! Hashes are cached; call clear() after modifying the drawing.
+class CellHasher
+{
+public:
+    //! Get content hash of cell (computed on first access)
+    uint64_t hash(const Cell* cell);
+
+    //! Compute hashes of all cells of the drawing, bottom-up
+    //!
+    //! Cells are processed by increasing number of child levels, such that the
+    //! hashes of child cells are cached when hashing their parents. The drawing
+    //! must be locked by the caller.
+    void precompute(const Drawing* dwg);
+
+    //! Get hash of cell object; for references, the hash of the referenced
+    //! cell must be cached already
+    uint64_t objectHash(const CellObject* obj) const;
+
+    //! Discard cached hashes
+    void clear() { cache_.clear(); }
+
+private:
+    // Compute hash of cell; hashes of child cells must be cached already
+    uint64_t compute(const Cell* cell) const;
+
+    // Get cached hash of cell
+    uint64_t cached(const Cell* cell) const;
+
+private:
+    std::unordered_map<const Cell*, uint64_t> cache_;
+};
+
+//! Merge structurally identical cells
+//!
+//! Cells with identical content (see CellHasher) are merged: all references
+//! to a duplicate are re-pointed to one canonical cell, and the duplicates
+//! are destroyed. The main cell is never destroyed. Cells are compared
+//! bottom-up, so that cells which only differ in referencing duplicate child
+//! cells are merged as well, regardless of the depth at which they are used.
+//!
+//! Shapes are compared with Shape::equivalentTo(other, ignoreSense), and
+//! references by canonical cell, layer, transformation and array parameters.
+//!
+//! The drawing must be write-locked by the caller.
+//!
+//! \param dwg          Drawing
+//! \param ignoreSense  If true, shapes only differing in orientation are
+//!                     considered identical
+//! \return             Number of cells removed
+size_t mergeDuplicateCells(Drawing* dwg, bool ignoreSense = true);
+
+//------------------------------------------------------------------------------
+inline uint64_t CellHasher::hash(const Cell* cell)
+{
+    if (auto it = cache_.find(cell); it != cache_.end())
+        return it->second;
+
+    // make sure child cells are cached
+    for (auto ref : cell->cellObjects<Ref>())
+    {
+        if (auto refCell = ref->refCell())
+            hash(refCell);
+    }
+
+    auto h = compute(cell);
+    cache_.emplace(cell, h);
+    return h;
+}
+
+//------------------------------------------------------------------------------
+inline void CellHasher::precompute(const Drawing* dwg)
+{
+    // group cells by child levels
+    std::map<unsigned int, std::vector<const Cell*>> levels;
+    for (auto cell : dwg->cells())
+    {
+        if (!cache_.contains(cell))
+            levels[cell->childLevels()].push_back(cell);
+    }
+
+    // hash leaf cells first; the drawing is only accessed from the calling
+    // thread, which holds the lock
+    for (auto&& [level, cells] : levels)
+    {
+        for (auto cell : cells)
+        {
+            cache_.emplace(cell, compute(cell));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t CellHasher::compute(const Cell* cell) const
+{
+    // sum of object hashes, independent of object order
+    uint64_t sum = 0;
+    uint64_t count = 0;
+
+    for (auto obj : cell->cellObjects<CellObject>())
+    {
+        sum += objectHash(obj);
+        ++count;
+    }
+
+    return hashCombine(hashMix(count), sum);
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t CellHasher::objectHash(const CellObject* obj) const
+{
+    if (obj->dynamicType() != ObjectType::Ref)
+        return shapeHash(static_cast<const Shape*>(obj));
+
+    auto ref = static_cast<const Ref*>(obj);
+    auto refCell = ref->refCell();
+
+    // rotation and scaling are compared with a tolerance, and are thus not hashed
+    const auto xform = ref->transformation();
+
+    auto h = hashMix(static_cast<uint64_t>(ObjectType::Ref));
+    h = hashCombine(h, cached(refCell));
+    h = hashCombine(h, reinterpret_cast<uintptr_t>(ref->layer()));
+    h = hashCombine(h, static_cast<uint64_t>(xform.translation().x));
+    h = hashCombine(h, static_cast<uint64_t>(xform.translation().y));
+    h = hashCombine(h, ref->columns());
+    h = hashCombine(h, ref->rows());
+    h = hashCombine(h, static_cast<uint64_t>(ref->columnSpacing()));
+    h = hashCombine(h, static_cast<uint64_t>(ref->rowSpacing()));
+    return h;
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t CellHasher::cached(const Cell* cell) const
+{
+    if (!cell)
+        return 0;
+
+    // cells not hashed yet only match themselves
+    auto it = cache_.find(cell);
+    return it != cache_.end() ? it->second : hashMix(reinterpret_cast<uintptr_t>(cell));
+}
+
+//------------------------------------------------------------------------------
+inline size_t mergeDuplicateCells(Drawing* dwg, bool ignoreSense /* = true */)
+{
+    CellHasher hasher;
+    hasher.precompute(dwg);
+
+    std::unordered_map<const Cell*, const Cell*> canonical;  // duplicate -> canonical cell
+    std::vector<std::pair<Cell*, Cell*>> merges;  // (duplicate, canonical cell)
+
+    auto canonicalOf = [&](const Cell* cell) {
+        auto it = canonical.find(cell);
+        return it != canonical.end() ? it->second : cell;
+    };
+
+    auto objectsEqual = [&](const CellObject* a, const CellObject* b) {
+        if (a->dynamicType() != b->dynamicType() || a->layer() != b->layer())
+            return false;
+
+        if (a->dynamicType() != ObjectType::Ref)
+            return static_cast<const Shape*>(a)->equivalentTo(static_cast<const Shape*>(b),
+                                                              ignoreSense);
+
+        auto refA = static_cast<const Ref*>(a);
+        auto refB = static_cast<const Ref*>(b);
+        return canonicalOf(refA->refCell()) == canonicalOf(refB->refCell()) &&
+               refA->transformation() == refB->transformation() &&
+               refA->columns() == refB->columns() && refA->rows() == refB->rows() &&
+               refA->columnSpacing() == refB->columnSpacing() &&
+               refA->rowSpacing() == refB->rowSpacing();
+    };
+
+    auto cellsEqual = [&](const Cell* a, const Cell* b) {
+        auto objectsA = a->cellObjects<CellObject>();
+        auto objectsB = b->cellObjects<CellObject>();
+        if (objectsA.size() != objectsB.size())
+            return false;
+
+        // bucket objects of b by hash, then match each object of a
+        std::unordered_multimap<uint64_t, const CellObject*> candidates;
+        candidates.reserve(objectsB.size());
+        for (auto obj : objectsB)
+        {
+            candidates.emplace(hasher.objectHash(obj), obj);
+        }
+
+        for (auto obj : objectsA)
+        {
+            auto [first, last] = candidates.equal_range(hasher.objectHash(obj));
+            auto match = std::find_if(first, last, [&](auto&& entry) {
+                return objectsEqual(obj, entry.second);
+            });
+            if (match == last)
+                return false;
+
+            candidates.erase(match);
+        }
+
+        return true;
+    };
+
+    // group cells by child levels; identical cells have the same number of
+    // child levels, even if they are used at different depths
+    std::map<unsigned int, std::vector<Cell*>> levels;
+    for (auto cell : dwg->cells())
+    {
+        levels[cell->childLevels()].push_back(cell);
+    }
+
+    // find duplicates bottom-up, such that child cells are canonical when
+    // comparing their parents
+    const Cell* mainCell = dwg->mainCell();
+    for (auto&& [level, cells] : levels)
+    {
+        std::unordered_map<uint64_t, std::vector<Cell*>> groups;
+        for (auto cell : cells)
+        {
+            groups[hasher.hash(cell)].push_back(cell);
+        }
+
+        for (auto&& [hash, group] : groups)
+        {
+            if (group.size() < 2)
+                continue;
+
+            // the main cell must survive, so make it the preferred canonical cell
+            std::stable_partition(group.begin(), group.end(),
+                                  [mainCell](const Cell* cell) { return cell == mainCell; });
+
+            std::vector<Cell*> distinct;
+            for (auto cell : group)
+            {
+                auto it = std::find_if(distinct.begin(), distinct.end(),
+                                       [&](const Cell* other) { return cellsEqual(cell, other); });
+                if (it != distinct.end() && cell != mainCell)
+                {
+                    canonical.emplace(cell, *it);
+                    merges.emplace_back(cell, *it);
+                }
+                else
+                    distinct.push_back(cell);
+            }
+        }
+    }
+
+    // re-point references to duplicates
+    std::vector<Ref*> refs;
+    for (auto&& [duplicate, cell] : merges)
+    {
+        auto cellRefs = duplicate->cellRefs();
+        refs.assign(cellRefs.begin(), cellRefs.end());
+        for (auto ref : refs)
+        {
+            ref->setRefCell(cell);
+        }
+    }
+
+    // destroy duplicates
+    for (auto&& [duplicate, cell] : merges)
+    {
+        duplicate->destroy();
+    }
+
+    return merges.size();
+}
+
+}  // namespace lc::db
@@ -0,0 +1,256 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Drawing.h"
+#include "Cell.h"
+#include "Layer.h"
+#include "Ref.h"
+#include "Polygon.h"
+#include "Polyline.h"
+#include "Nurbs.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lc::db {
+
+//! Structured breakdown of the contents of a drawing
+//!
+//! Complements Drawing::memoryUsage() with object and vertex counts per object
+//! type, per cell and per layer, to find the parts of a drawing responsible
+//! for its memory footprint.
+//!
+//! Use like this:
+//!
+//!     Drawing::ReadLock lock;
+//!     auto stats = DrawingStatistics::collect(dwg);
+//!     stats.writeJson(std::cout);
+struct DrawingStatistics
+{
+    //! Statistics of a single cell
+    struct CellStatistics
+    {
+        const Cell* cell = nullptr;
+        uint64_t objects = 0;  //!< cell objects in cell
+        uint64_t vertices = 0;  //!< polygon/polyline vertices and NURBS control points in cell
+        uint64_t flatObjects = 0;  //!< cell objects in cell and all instantiated sub-cells
+        uint64_t flatVertices = 0;  //!< vertices in cell and all instantiated sub-cells
+    };
+
+    //! Statistics of a single layer
+    struct LayerStatistics
+    {
+        const Layer* layer = nullptr;
+        uint64_t shapes = 0;  //!< shapes on layer (all cells, not flattened)
+        uint64_t vertices = 0;  //!< vertices of shapes on layer
+    };
+
+    size_t memoryUsage = 0;  //!< total memory in use by database (see Drawing::memoryUsage())
+    std::array<uint64_t, static_cast<size_t>(ObjectType::_Last)> objects{};  //!< count by type
+    uint64_t vertices = 0;  //!< total vertices
+    uint64_t vertexBytes = 0;  //!< minimum storage required for vertices
+    std::vector<CellStatistics> cells;
+    std::vector<LayerStatistics> layers;
+
+    //! Collect statistics (drawing must be read-locked)
+    static DrawingStatistics collect(const Drawing* dwg);
+
+    //! Write statistics as JSON object
+    void writeJson(std::ostream& os) const;
+
+private:
+    // Compute flattened counts of cell
+    static const CellStatistics& flatten(
+        const Cell* cell,
+        std::unordered_map<const Cell*, CellStatistics*>& byCell);
+
+    // Write JSON string
+    static void writeJsonString(std::ostream& os, std::string_view str);
+};
+
+//------------------------------------------------------------------------------
+inline DrawingStatistics DrawingStatistics::collect(const Drawing* dwg)
+{
+    DrawingStatistics stats;
+    stats.memoryUsage = Drawing::memoryUsage();
+
+    std::unordered_map<const Layer*, size_t> layerIndex;
+    for (auto layer : dwg->layers())
+    {
+        layerIndex.emplace(layer, stats.layers.size());
+        stats.layers.push_back({layer});
+        ++stats.objects[static_cast<size_t>(ObjectType::Layer)];
+    }
+
+    auto layerStats = [&](const Layer* layer) -> LayerStatistics& {
+        auto [it, inserted] = layerIndex.try_emplace(layer, stats.layers.size());
+        if (inserted)
+            stats.layers.push_back({layer});  // hidden layer
+
+        return stats.layers[it->second];
+    };
+
+    for (auto cell : dwg->cells())
+    {
+        CellStatistics cellStats{cell};
+        ++stats.objects[static_cast<size_t>(ObjectType::Cell)];
+
+        for (auto obj : cell->cellObjects<CellObject>())
+        {
+            auto type = obj->dynamicType();
+            ++stats.objects[static_cast<size_t>(type)];
+            ++cellStats.objects;
+
+            if (!isShape(type))
+                continue;
+
+            auto shape = static_cast<const Shape*>(obj);
+            size_t vertexCount = 0;
+
+            if (type == ObjectType::Polygon)
+                vertexCount = static_cast<const Polygon*>(shape)->vertexCount();
+            else if (type == ObjectType::Polyline)
+                vertexCount = static_cast<const Polyline*>(shape)->vertexCount();
+            else if (type == ObjectType::Nurbs)
+                vertexCount = static_cast<const Nurbs*>(shape)->controlPointCount();
+
+            cellStats.vertices += vertexCount;
+
+            auto& ls = layerStats(shape->layer());
+            ++ls.shapes;
+            ls.vertices += vertexCount;
+        }
+
+        stats.vertices += cellStats.vertices;
+        stats.cells.push_back(cellStats);
+    }
+
+    stats.vertexBytes = stats.vertices * sizeof(Point);
+
+    std::unordered_map<const Cell*, CellStatistics*> byCell;
+    for (auto&& cellStats : stats.cells)
+    {
+        byCell.emplace(cellStats.cell, &cellStats);
+    }
+
+    for (auto&& cellStats : stats.cells)
+    {
+        flatten(cellStats.cell, byCell);
+    }
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+inline const DrawingStatistics::CellStatistics& DrawingStatistics::flatten(
+    const Cell* cell,
+    std::unordered_map<const Cell*, CellStatistics*>& byCell)
+{
+    auto& cellStats = *byCell.at(cell);
+
+    // cells are visited at most once, as the hierarchy is acyclic
+    if (cellStats.flatObjects != 0 || cellStats.objects == 0)
+        return cellStats;
+
+    cellStats.flatObjects = cellStats.objects;
+    cellStats.flatVertices = cellStats.vertices;
+
+    for (auto ref : cell->cellObjects<Ref>())
+    {
+        if (auto refCell = ref->refCell())
+        {
+            const auto& child = flatten(refCell, byCell);
+            uint64_t instances = uint64_t{ref->columns()} * ref->rows();
+            cellStats.flatObjects += child.flatObjects * instances;
+            cellStats.flatVertices += child.flatVertices * instances;
+        }
+    }
+
+    return cellStats;
+}
+
+//------------------------------------------------------------------------------
+inline void DrawingStatistics::writeJson(std::ostream& os) const
+{
+    os << "{\"memoryUsage\":" << memoryUsage << ",\"vertices\":" << vertices
+       << ",\"vertexBytes\":" << vertexBytes << ",\"objects\":{";
+
+    bool first = true;
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        if (objects[i] == 0)
+            continue;
+
+        os << (first ? "" : ",");
+        writeJsonString(os, nameOf(static_cast<ObjectType>(i)));
+        os << ":" << objects[i];
+        first = false;
+    }
+
+    os << "},\"cells\":[";
+
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        const auto& c = cells[i];
+        os << (i ? "," : "") << "{\"name\":";
+        writeJsonString(os, c.cell->name());
+        os << ",\"objects\":" << c.objects << ",\"vertices\":" << c.vertices
+           << ",\"flatObjects\":" << c.flatObjects << ",\"flatVertices\":" << c.flatVertices
+           << "}";
+    }
+
+    os << "],\"layers\":[";
+
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        const auto& l = layers[i];
+        os << (i ? "," : "") << "{\"name\":";
+        writeJsonString(os, l.layer ? std::string_view(l.layer->name()) : std::string_view());
+        os << ",\"shapes\":" << l.shapes << ",\"vertices\":" << l.vertices << "}";
+    }
+
+    os << "]}";
+}
+
+//------------------------------------------------------------------------------
+inline void DrawingStatistics::writeJsonString(std::ostream& os, std::string_view str)
+{
+    os << '"';
+
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\r': os << "\\r"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                os << buf;
+            }
+            else
+            {
+                os << c;
+            }
+        }
+    }
+
+    os << '"';
+}
+
+}  // namespace lc::db
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Drawing.h"
+#include "Cell.h"
+#include "Shape.h"
+#include "CellHasher.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace lc::db {
+
+//! Find shapes in cell which duplicate another shape of the same cell
+//!
+//! Shapes are bucketed by shapeHash(), and only shapes within a bucket are
+//! compared using Shape::equivalentTo(), so that the expected effort is linear
+//! in the number of shapes. Of each set of identical shapes, the first one
+//! encountered is kept, all others are reported as duplicates.
+//!
+//! \param cell         Cell
+//! \param duplicates   [out] Duplicate shapes (appended)
+//! \param ignoreSense  If true, shapes only differing in orientation are
+//!                     considered identical
+void findDuplicateShapes(Cell* cell, std::vector<Shape*>& duplicates, bool ignoreSense = true);
+
+//! Remove shapes duplicating another shape in the same cell
+//!
+//! The drawing must be write-locked by the caller.
+//!
+//! \return Number of shapes removed
+size_t removeDuplicateShapes(Cell* cell, bool ignoreSense = true);
+
+//! Remove shapes duplicating another shape in the same cell, for all cells
+//!
+//! The drawing must be write-locked by the caller.
+//!
+//! \return Number of shapes removed
+size_t removeDuplicateShapes(Drawing* dwg, bool ignoreSense = true);
+
+//------------------------------------------------------------------------------
+inline void findDuplicateShapes(Cell* cell,
+                                std::vector<Shape*>& duplicates,
+                                bool ignoreSense /* = true */)
+{
+    // first shape of each set of identical shapes, by hash
+    std::unordered_multimap<uint64_t, const Shape*> unique;
+
+    for (auto shape : cell->cellObjects<Shape>())
+    {
+        auto hash = shapeHash(shape);
+        auto [first, last] = unique.equal_range(hash);
+
+        auto isDuplicate = std::any_of(first, last, [&](auto&& entry) {
+            return entry.second->layer() == shape->layer() &&
+                   entry.second->equivalentTo(shape, ignoreSense);
+        });
+
+        if (isDuplicate)
+            duplicates.push_back(shape);
+        else
+            unique.emplace(hash, shape);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline size_t removeDuplicateShapes(Cell* cell, bool ignoreSense /* = true */)
+{
+    std::vector<Shape*> duplicates;
+    findDuplicateShapes(cell, duplicates, ignoreSense);
+
+    for (auto shape : duplicates)
+    {
+        shape->destroy();
+    }
+
+    return duplicates.size();
+}
+
+//------------------------------------------------------------------------------
+inline size_t removeDuplicateShapes(Drawing* dwg, bool ignoreSense /* = true */)
+{
+    size_t count = 0;
+    for (auto cell : dwg->cells())
+    {
+        count += removeDuplicateShapes(cell, ignoreSense);
+    }
+
+    return count;
+}
+
+}  // namespace lc::db
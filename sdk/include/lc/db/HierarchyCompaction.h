@@ -0,0 +1,386 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Drawing.h"
+#include "Cell.h"
+#include "Ref.h"
+#include "Polygon.h"
+#include "ArrayRefs.h"
+#include "BoundsClustering.h"
+#include <lc/geom/PointHash.h>
+#include <lc/util/lcassert.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace lc::db {
+
+//! Options for compactHierarchy()
+struct CompactionOptions
+{
+    unsigned int minShapes = 2;  //!< minimum number of polygons per constellation
+    unsigned int minOccurrences = 4;  //!< minimum number of occurrences of a constellation
+    bool createArrays = true;  //!< replace regular lattices of occurrences by array refs
+};
+
+//! Promote repeated polygon constellations of a cell into new cells
+//!
+//! Polygons are classified by shape, translation invariantly (layer, vertices
+//! relative to the lower left corner of their bounds, and bulges). Starting
+//! with the rarest shapes, all polygons of a shape seed the occurrences of a
+//! pattern, which is grown by neighbouring polygons (with overlapping or
+//! touching bounds) found at the same offset and with the same shape in every
+//! occurrence. While the pattern has less than `minShapes` polygons,
+//! occurrences lacking the most common neighbour are dropped instead, as long
+//! as `minOccurrences` remain. Thus, abutting copies of a constellation are
+//! found, since polygons of adjacent copies are not shared by all occurrences.
+//!
+//! Each pattern is moved into a new cell (named after the compacted cell, with
+//! a numeric suffix), and its occurrences are replaced by references, which
+//! are optionally combined into array references (see recognizeArrayRefs()).
+//! References that existed before are left unchanged.
+//!
+//! Only polygons are considered, as these make up the bulk of flattened
+//! layouts; other cell objects are left in place. Each polygon is part of at
+//! most one pattern, and patterns are only grown through polygons with
+//! overlapping or touching bounds. Occurrences are only found if the polygons'
+//! vertices are identical, including their start vertex and orientation.
+//!
+//! The drawing must be write-locked by the caller.
+//!
+//! \param cell     Cell to compact
+//! \param options  Options
+//! \return         Number of cells created
+size_t compactHierarchy(Cell* cell, const CompactionOptions& options = {});
+
+namespace detail {
+
+// Polygon considered for compaction
+struct CompactionPolygon
+{
+    Polygon* poly;
+    Point pos;  // lower left corner of bounds
+    PointArray vertices;  // relative to pos
+    std::vector<double> bulges;
+    size_t shape = 0;  // index of shape class
+    std::vector<size_t> neighbours;  // polygons with overlapping or touching bounds
+};
+
+// Polygon of a pattern, by shape and offset relative to the pattern's seed
+struct PatternKey
+{
+    size_t shape;
+    coord dx, dy;
+
+    bool operator<(const PatternKey& other) const
+    {
+        return std::tie(shape, dx, dy) < std::tie(other.shape, other.dx, other.dy);
+    }
+};
+
+// Repeated pattern of polygons
+struct Pattern
+{
+    std::vector<PatternKey> keys;
+    std::vector<std::vector<size_t>> occurrences;  // polygons, in order of keys
+};
+
+//------------------------------------------------------------------------------
+// Grow a pattern from seed polygons of the same shape, returning an empty
+// pattern if it doesn't reach minShapes polygons in minOccurrences occurrences
+inline Pattern growPattern(const std::vector<CompactionPolygon>& polygons,
+                           const std::vector<bool>& claimed,
+                           const std::vector<size_t>& seeds,
+                           unsigned int minShapes,
+                           unsigned int minOccurrences)
+{
+    constexpr size_t none = ~size_t{0};
+
+    Pattern pattern;
+    pattern.keys.push_back({polygons[seeds.front()].shape, 0, 0});
+    // polygons that are part of an occurrence
+    std::unordered_set<size_t> owned;
+
+    // seeds at the same position (duplicate polygons) would share neighbours,
+    // so only the first one starts an occurrence
+    std::unordered_set<Point, geom::PointHash> positions;
+    for (auto seed : seeds)
+    {
+        if (positions.insert(polygons[seed].pos).second)
+        {
+            pattern.occurrences.push_back({seed});
+            owned.insert(seed);
+        }
+    }
+
+    if (pattern.occurrences.size() < minOccurrences)
+        return {};
+
+    // test if a polygon matches in more than one occurrence
+    auto isShared = [&](std::vector<size_t> matches) {
+        std::erase(matches, none);
+        std::sort(matches.begin(), matches.end());
+        return std::adjacent_find(matches.begin(), matches.end()) != matches.end();
+    };
+
+    for (;;)
+    {
+        auto& occurrences = pattern.occurrences;
+
+        // neighbours of each occurrence, by shape and offset from the seed
+        std::map<PatternKey, std::vector<size_t>> candidates;
+        for (size_t k = 0; k < occurrences.size(); ++k)
+        {
+            const auto& origin = polygons[occurrences[k].front()].pos;
+            for (auto i : occurrences[k])
+            {
+                for (auto j : polygons[i].neighbours)
+                {
+                    if (claimed[j] || owned.contains(j))
+                        continue;
+
+                    const auto& p = polygons[j];
+                    auto& matches = candidates[{p.shape, p.pos.x - origin.x, p.pos.y - origin.y}];
+                    if (matches.empty())
+                        matches.resize(occurrences.size(), none);
+
+                    if (matches[k] == none)
+                        matches[k] = j;
+                }
+            }
+        }
+
+        // add neighbours found in all occurrences, unless taken by another key
+        bool grown = false;
+        for (auto&& [key, matches] : candidates)
+        {
+            if (std::any_of(matches.begin(), matches.end(),
+                            [&](size_t j) { return j == none || owned.contains(j); }) ||
+                isShared(matches))
+                continue;
+
+            for (size_t k = 0; k < occurrences.size(); ++k)
+            {
+                occurrences[k].push_back(matches[k]);
+                owned.insert(matches[k]);
+            }
+
+            pattern.keys.push_back(key);
+            grown = true;
+        }
+
+        if (grown)
+            continue;
+
+        if (pattern.keys.size() >= minShapes)
+            return pattern;
+
+        // pattern too small: drop occurrences lacking the most common neighbour
+        const std::vector<size_t>* best = nullptr;
+        const PatternKey* bestKey = nullptr;
+        size_t bestCount = 0;
+        for (auto&& [key, matches] : candidates)
+        {
+            auto count = matches.size() - std::count(matches.begin(), matches.end(), none);
+            if (count > bestCount && !isShared(matches))
+            {
+                best = &matches;
+                bestKey = &key;
+                bestCount = count;
+            }
+        }
+
+        if (bestCount < minOccurrences)
+            return {};
+
+        std::vector<std::vector<size_t>> kept;
+        owned.clear();
+        for (size_t k = 0; k < occurrences.size(); ++k)
+        {
+            if ((*best)[k] == none)
+                continue;
+
+            kept.push_back(std::move(occurrences[k]));
+            kept.back().push_back((*best)[k]);
+            owned.insert(kept.back().begin(), kept.back().end());
+        }
+
+        occurrences = std::move(kept);
+        pattern.keys.push_back(*bestKey);
+    }
+}
+
+}  // namespace detail
+
+//------------------------------------------------------------------------------
+inline size_t compactHierarchy(Cell* cell, const CompactionOptions& options /* = {} */)
+{
+    using detail::CompactionPolygon;
+
+    std::vector<CompactionPolygon> polygons;
+    std::vector<Bounds> bounds;
+    for (auto poly : cell->cellObjects<Polygon>())
+    {
+        bounds.push_back(poly->bounds());
+        polygons.push_back({poly, bounds.back().minXY(), {}, {}, 0, {}});
+    }
+
+    if (polygons.empty() || polygons.size() < size_t{options.minShapes} * options.minOccurrences)
+        return 0;
+
+    // very large polygons (e.g. planes) are never part of a repeated pattern,
+    // so don't make them neighbours of everything else
+    detail::forEachOverlappingPair(bounds, false, [&](size_t i, size_t j) {
+        polygons[i].neighbours.push_back(j);
+        polygons[j].neighbours.push_back(i);
+    });
+
+    // classify polygons by shape, confirmed by exact comparison
+    std::vector<std::vector<size_t>> shapes;
+    std::unordered_map<uint64_t, std::vector<size_t>> shapesByHash;
+    for (size_t i = 0; i < polygons.size(); ++i)
+    {
+        auto& p = polygons[i];
+        p.poly->vertices(p.vertices, p.bulges);
+
+        const Vector offset(-p.pos.x, -p.pos.y);
+        auto hash = geom::hashCombine(geom::hashMix(p.vertices.size()),
+                                      reinterpret_cast<uintptr_t>(p.poly->layer()));
+        for (auto&& pt : p.vertices)
+        {
+            pt += offset;
+            hash = geom::hashCombine(hash, geom::PointHash{}(pt));
+        }
+
+        auto& indices = shapesByHash[hash];
+        auto it = std::find_if(indices.begin(), indices.end(), [&](size_t shape) {
+            const auto& q = polygons[shapes[shape].front()];
+            return q.poly->layer() == p.poly->layer() && q.vertices == p.vertices &&
+                   q.bulges == p.bulges;
+        });
+
+        if (it != indices.end())
+        {
+            p.shape = *it;
+        }
+        else
+        {
+            p.shape = shapes.size();
+            indices.push_back(p.shape);
+            shapes.emplace_back();
+        }
+
+        shapes[p.shape].push_back(i);
+    }
+
+    // seed patterns with the rarest shapes first, as these are most distinctive
+    std::vector<size_t> seedShapes(shapes.size());
+    for (size_t s = 0; s < shapes.size(); ++s)
+    {
+        seedShapes[s] = s;
+    }
+
+    std::stable_sort(seedShapes.begin(), seedShapes.end(),
+                     [&](size_t a, size_t b) { return shapes[a].size() < shapes[b].size(); });
+
+    std::vector<detail::Pattern> patterns;
+    std::vector<bool> claimed(polygons.size());
+    for (auto shape : seedShapes)
+    {
+        // occurrences dropped while growing a pattern may seed another one
+        for (;;)
+        {
+            std::vector<size_t> seeds;
+            for (auto i : shapes[shape])
+            {
+                if (!claimed[i])
+                    seeds.push_back(i);
+            }
+
+            if (seeds.size() < options.minOccurrences)
+                break;
+
+            auto pattern = detail::growPattern(polygons, claimed, seeds, options.minShapes,
+                                               options.minOccurrences);
+            if (pattern.occurrences.empty())
+                break;
+
+            for (auto&& occurrence : pattern.occurrences)
+            {
+                for (auto i : occurrence)
+                {
+                    // each polygon is destroyed by exactly one occurrence
+                    ASSERT(!claimed[i]);
+                    claimed[i] = true;
+                }
+            }
+
+            patterns.push_back(std::move(pattern));
+        }
+    }
+
+    // extract patterns into new cells
+    auto dwg = cell->drawing();
+    size_t created = 0;
+    size_t suffix = 0;
+    std::vector<Ref*> refs;
+
+    for (auto&& pattern : patterns)
+    {
+        std::string name;
+        do
+        {
+            name = cell->name() + "_" + std::to_string(++suffix);
+        } while (Cell::lookup(dwg, name));
+
+        auto newCell = Cell::createInstance(dwg, name);
+
+        // lower left corner of pattern, relative to its seed
+        Vector corner(0, 0);
+        for (auto&& key : pattern.keys)
+        {
+            corner = Vector(std::min(corner.x, key.dx), std::min(corner.y, key.dy));
+        }
+
+        auto origin = [&](const std::vector<size_t>& occurrence) {
+            return polygons[occurrence.front()].pos + corner;
+        };
+
+        const auto first = origin(pattern.occurrences.front());
+        const Xform toOrigin(Vector(-first.x, -first.y));
+        for (auto i : pattern.occurrences.front())
+        {
+            polygons[i].poly->clone(newCell, toOrigin);
+        }
+
+        for (auto&& occurrence : pattern.occurrences)
+        {
+            const auto pt = origin(occurrence);
+            refs.push_back(Ref::createInstance(cell, nullptr, Xform(Vector(pt.x, pt.y)), newCell));
+
+            for (auto i : occurrence)
+            {
+                polygons[i].poly->destroy();
+            }
+        }
+
+        ++created;
+    }
+
+    if (created != 0 && options.createArrays)
+        recognizeArrayRefs(refs, options.minOccurrences);
+
+    return created;
+}
+
+}  // namespace lc::db
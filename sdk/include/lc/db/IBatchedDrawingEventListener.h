@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "dbdefs.h"
+#include "Drawing.h"
+#include "IDrawingEventListener.h"
+#include <algorithm>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+namespace lc::db {
+
+class Object;
+class Drawing;
+class Cell;
+
+//------------------------------------------------------------------------------
+// Interface for objects wanting to receive Drawing object events in batches
+//
+// See: DrawingEventBatcher
+//------------------------------------------------------------------------------
+struct NOVTABLE IBatchedDrawingEventListener
+{
+    virtual ~IBatchedDrawingEventListener() = 0;
+
+    // The top cell has been changed
+    virtual void onMainCellChanged(Drawing* drawing, Cell* oldCell) = 0;
+
+    // New Objects have been added to the Drawing
+    virtual void onObjectsAdded(Drawing* drawing, std::span<Object* const> objects) = 0;
+
+    // Objects have been modified (each object is reported once per batch)
+    virtual void onObjectsModified(Drawing* drawing, std::span<Object* const> objects) = 0;
+
+    // Objects have been deleted from memory; the pointers only identify the
+    // objects and must not be dereferenced
+    virtual void onObjectsDestroyed(Drawing* drawing, std::span<const Object* const> objects) = 0;
+};
+
+inline IBatchedDrawingEventListener::~IBatchedDrawingEventListener() = default;
+
+//------------------------------------------------------------------------------
+// Adapter collecting per-object drawing events into batches
+//
+// Description:
+//      The batcher registers itself as IDrawingEventListener with the drawing
+//      and forwards events to an IBatchedDrawingEventListener whenever
+//      `batchSize` events are pending, when flush() is called (typically right
+//      after committing a Drawing::Transaction), and on destruction.
+//
+//      Pending added or modified objects are flushed before they are
+//      destroyed, so that pointers passed to onObjectsAdded() and
+//      onObjectsModified() are always valid.
+//------------------------------------------------------------------------------
+class DrawingEventBatcher final : public IDrawingEventListener
+{
+public:
+    // Constructor, registers the batcher with the drawing
+    DrawingEventBatcher(Drawing* dwg,
+                        IBatchedDrawingEventListener* target,
+                        size_t batchSize = 4096);
+
+    // Destructor, flushes pending events and unregisters the batcher
+    ~DrawingEventBatcher() override;
+
+    DrawingEventBatcher(const DrawingEventBatcher&) = delete;
+    DrawingEventBatcher& operator=(const DrawingEventBatcher&) = delete;
+
+    // Forward all pending events
+    void flush();
+
+    // Get number of pending events
+    size_t pendingCount() const { return added_.size() + modified_.size() + destroyed_.size(); }
+
+protected:
+    // IDrawingEventListener
+    void onMainCellChanged(Drawing* drawing, Cell* oldCell) override;
+    void onObjectAdded(Drawing* drawing, Object* object) override;
+    void onObjectModified(Drawing* drawing, Object* object) override;
+    void onObjectDestroy(Drawing* drawing, const Object* object) override;
+
+private:
+    // Flush if batch size reached
+    void flushIfFull();
+
+private:
+    Drawing* dwg_;
+    IBatchedDrawingEventListener* target_;
+    size_t batchSize_;
+    std::vector<Object*> added_;
+    std::vector<Object*> modified_;
+    std::vector<const Object*> destroyed_;
+    std::unordered_set<const Object*> pending_;  // objects in added_ or modified_
+};
+
+//------------------------------------------------------------------------------
+inline DrawingEventBatcher::DrawingEventBatcher(Drawing* dwg,
+                                                IBatchedDrawingEventListener* target,
+                                                size_t batchSize /* = 4096 */)
+    : dwg_(dwg)
+    , target_(target)
+    , batchSize_(std::max<size_t>(batchSize, 1))
+{
+    dwg_->addListener(this);
+}
+
+//------------------------------------------------------------------------------
+inline DrawingEventBatcher::~DrawingEventBatcher()
+{
+    dwg_->removeListener(this);
+    flush();
+}
+
+//------------------------------------------------------------------------------
+inline void DrawingEventBatcher::flush()
+{
+    // destroyed objects go first, as their addresses may have been reused by
+    // objects added afterwards
+    if (!destroyed_.empty())
+    {
+        target_->onObjectsDestroyed(dwg_, destroyed_);
+        destroyed_.clear();
+    }
+
+    if (!added_.empty())
+    {
+        target_->onObjectsAdded(dwg_, added_);
+        added_.clear();
+    }
+
+    if (!modified_.empty())
+    {
+        target_->onObjectsModified(dwg_, modified_);
+        modified_.clear();
+    }
+
+    pending_.clear();
+}
+
+//------------------------------------------------------------------------------
+inline void DrawingEventBatcher::onMainCellChanged(Drawing* drawing, Cell* oldCell)
+{
+    flush();
+    target_->onMainCellChanged(drawing, oldCell);
+}
+
+//------------------------------------------------------------------------------
+inline void DrawingEventBatcher::onObjectAdded(Drawing* /*drawing*/, Object* object)
+{
+    pending_.insert(object);
+    added_.push_back(object);
+    flushIfFull();
+}
+
+//------------------------------------------------------------------------------
+inline void DrawingEventBatcher::onObjectModified(Drawing* /*drawing*/, Object* object)
+{
+    // objects added or modified in the current batch are reported only once
+    if (pending_.insert(object).second)
+    {
+        modified_.push_back(object);
+        flushIfFull();
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void DrawingEventBatcher::onObjectDestroy(Drawing* /*drawing*/, const Object* object)
+{
+    // deliver pending events referring to the object while it is still alive
+    if (pending_.contains(object))
+        flush();
+
+    destroyed_.push_back(object);
+    flushIfFull();
+}
+
+//------------------------------------------------------------------------------
+inline void DrawingEventBatcher::flushIfFull()
+{
+    if (pendingCount() >= batchSize_)
+        flush();
+}
+
+}  // namespace lc::db
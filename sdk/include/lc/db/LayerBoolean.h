@@ -0,0 +1,273 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Cell.h"
+#include "Layer.h"
+#include "Polygon.h"
+#include "BoundsClustering.h"
+#include <lc/geom/PointHash.h>
+#include <lc/geom/PolygonBoolean.h>
+#include <lc/geom/SelfIntersection.h>
+#include <algorithm>
+#include <exception>
+#include <execution>
+#include <unordered_map>
+#include <vector>
+
+namespace lc::db {
+
+using geom::BooleanOp;
+
+//! Compute Boolean operation between the polygons on two layers of a cell
+//!
+//! The polygons on \c layerA and \c layerB are combined using \c op (see
+//! geom::booleanOp()), and the result is created on layer \c target, with
+//! holes linked to their enclosing contour. If \c target is one of the
+//! operand layers, its polygons are replaced by the result. Polygons with
+//! bulges are approximated using \c res; other shapes are ignored.
+//!
+//! The polygons are partitioned into clusters with overlapping bounds, which
+//! don't interact and are thus processed independently and in parallel. The
+//! polygons' vertices are extracted on the calling thread; worker threads
+//! don't access the drawing. A single connected cluster (e.g. a plane with
+//! many cut-outs) is processed by one thread. Clusters whose result equals
+//! their polygons (e.g. isolated simple polygons in a union) are left
+//! untouched, preserving the polygons' properties; if they aren't on
+//! \c target, they are copied there.
+//!
+//! The drawing must be write-locked by the caller.
+//!
+//! If the operation fails for any cluster (see geom::booleanOp() and
+//! geom::linkHoles()), the exception is rethrown before the drawing is
+//! modified.
+//!
+//! \param cell      Cell
+//! \param op        Operation
+//! \param layerA    Layer of operand A
+//! \param layerB    Layer of operand B
+//! \param target    Layer of result
+//! \param res       Resolution for approximating bulges
+//! \param fillRule  Fill rule of operand polygons
+//! \return          Number of polygons created (unchanged polygons are not
+//!                  counted)
+size_t booleanLayers(Cell* cell,
+                     BooleanOp op,
+                     const Layer* layerA,
+                     const Layer* layerB,
+                     const Layer* target,
+                     const Resolution& res,
+                     FillRule fillRule = FillRule::NonZero);
+
+//! Merge overlapping polygons on a layer of a cell
+//!
+//! Replaces the polygons on the layer by their union, e.g. before exporting
+//! to formats requiring non-overlapping polygons.
+//!
+//! See: booleanLayers()
+size_t mergeLayer(Cell* cell,
+                  const Layer* layer,
+                  const Resolution& res,
+                  FillRule fillRule = FillRule::NonZero);
+
+namespace detail {
+
+//------------------------------------------------------------------------------
+// Test if two contours consist of the same vertices, regardless of starting
+// vertex and orientation
+inline bool isSameContour(const PointArray& a, const PointArray& b)
+{
+    const size_t n = a.size();
+    if (n != b.size())
+        return false;
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        if (a[k] != b[0])
+            continue;
+
+        bool forward = true, backward = true;
+        for (size_t i = 1; i < n && (forward || backward); ++i)
+        {
+            forward = forward && a[(k + i) % n] == b[i];
+            backward = backward && a[(k + n - i) % n] == b[i];
+        }
+
+        if (forward || backward)
+            return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// Test if the result of a Boolean operation consists of the operand contours
+// of a cluster
+inline bool isSameContourSet(const geom::PolygonSet<coord>& result,
+                             const std::vector<PointArray>& contours,
+                             const std::vector<size_t>& cluster)
+{
+    if (result.size() != cluster.size())
+        return false;
+
+    // index operand contours by their smallest vertex
+    std::unordered_multimap<Point, size_t, geom::PointHash> candidates;
+    for (auto i : cluster)
+    {
+        if (contours[i].empty())
+            return false;
+
+        candidates.emplace(*std::min_element(contours[i].begin(), contours[i].end()), i);
+    }
+
+    for (auto&& contour : result)
+    {
+        auto [first, last] =
+            candidates.equal_range(*std::min_element(contour.begin(), contour.end()));
+        auto match = std::find_if(first, last, [&](auto&& entry) {
+            return isSameContour(contours[entry.second], contour);
+        });
+        if (match == last)
+            return false;
+
+        candidates.erase(match);
+    }
+
+    return true;
+}
+
+}  // namespace detail
+
+//------------------------------------------------------------------------------
+inline size_t booleanLayers(Cell* cell,
+                            BooleanOp op,
+                            const Layer* layerA,
+                            const Layer* layerB,
+                            const Layer* target,
+                            const Resolution& res,
+                            FillRule fillRule /* = FillRule::NonZero */)
+{
+    std::vector<Polygon*> polygons;
+    std::vector<bool> operandB;
+    std::vector<Bounds> bounds;
+    std::vector<PointArray> contours;
+    std::vector<double> bulges;
+
+    // the drawing is only accessed from the calling thread, which holds the
+    // lock; worker threads only operate on the extracted contours
+    for (auto poly : cell->cellObjects<Polygon>())
+    {
+        auto layer = poly->layer();
+        if (layer != layerA && layer != layerB)
+            continue;
+
+        PointArray vertices;
+        poly->vertices(vertices, bulges);
+        if (std::any_of(bulges.begin(), bulges.end(), [](double v) { return v != 0; }))
+            poly->samplePoints(vertices, res, VertexMode::NoDuplicateEnd);
+
+        polygons.push_back(poly);
+        operandB.push_back(layer != layerA);
+        bounds.push_back(poly->bounds());
+        contours.push_back(std::move(vertices));
+    }
+
+    auto clusters = detail::clusterBounds(bounds, true);
+
+    // exceptions must not escape the worker threads
+    struct ClusterResult
+    {
+        geom::PolygonSet<coord> contours;
+        bool unchanged = false;  // result equals the cluster's polygons
+        std::exception_ptr error;
+    };
+
+    std::vector<ClusterResult> results(clusters.size());
+    std::transform(
+        std::execution::par, clusters.begin(), clusters.end(), results.begin(),
+        [&](const std::vector<size_t>& cluster) {
+            ClusterResult result;
+
+            // an isolated simple polygon is kept unless it is intersected or
+            // subtracted; self-intersecting polygons are normalized according
+            // to the fill rule
+            if (cluster.size() == 1 && !geom::isSelfIntersecting(contours[cluster[0]]))
+            {
+                result.unchanged = op == BooleanOp::Union || op == BooleanOp::Xor ||
+                                   (op == BooleanOp::Difference && !operandB[cluster[0]]);
+                return result;
+            }
+
+            geom::PolygonSet<coord> a, b;
+            for (auto i : cluster)
+            {
+                (operandB[i] ? b : a).push_back(contours[i]);
+            }
+
+            try
+            {
+                result.contours = geom::linkHoles(geom::booleanOp(a, b, op, fillRule));
+                result.unchanged = detail::isSameContourSet(result.contours, contours, cluster);
+            }
+            catch (...)
+            {
+                result.error = std::current_exception();
+            }
+
+            return result;
+        });
+
+    for (auto&& result : results)
+    {
+        if (result.error)
+            std::rethrow_exception(result.error);
+    }
+
+    size_t created = 0;
+    for (size_t k = 0; k < clusters.size(); ++k)
+    {
+        if (results[k].unchanged)
+        {
+            for (auto i : clusters[k])
+            {
+                if (polygons[i]->layer() != target)
+                {
+                    polygons[i]->clone()->setLayer(target);
+                    ++created;
+                }
+            }
+
+            continue;
+        }
+
+        for (auto i : clusters[k])
+        {
+            if (polygons[i]->layer() == target)
+                polygons[i]->destroy();
+        }
+
+        for (auto&& contour : results[k].contours)
+        {
+            Polygon::createInstance(cell, target, contour);
+            ++created;
+        }
+    }
+
+    return created;
+}
+
+//------------------------------------------------------------------------------
+inline size_t mergeLayer(Cell* cell,
+                         const Layer* layer,
+                         const Resolution& res,
+                         FillRule fillRule /* = FillRule::NonZero */)
+{
+    return booleanLayers(cell, BooleanOp::Union, layer, layer, layer, res, fillRule);
+}
+
+}  // namespace lc::db
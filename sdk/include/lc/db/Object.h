@@ -128,7 +128,7 @@ TPtr dynamicCast(U* obj)
     ObjectType type = obj->dynamicType();
     ObjectType baseType = T::staticType();
 
-    if (type == baseType || isDerivedFrom(type, baseType))
+    if (isKindOf(type, baseType))
         return static_cast<TPtr>(obj);
     else
         return nullptr;
@@ -9,6 +9,8 @@
 
 #include "dbdefs.h"
 #include "dllexport.h"
+#include <array>
+#include <cstdint>
 
 namespace lc::db {
 
@@ -78,4 +80,72 @@ inline int operator-(ObjectType type, ObjectType base)
     return static_cast<int>(type) - static_cast<int>(base);
 }
 
+//! Check if type is a cell object type (Ref or any shape)
+constexpr bool isCellObject(ObjectType type)
+{
+    return type >= ObjectType::_CellObjectFirst && type <= ObjectType::_CellObjectLast;
+}
+
+//! Check if type is a shape type
+constexpr bool isShape(ObjectType type)
+{
+    return type >= ObjectType::_ShapeFirst && type <= ObjectType::_ShapeLast;
+}
+
+namespace detail {
+
+static_assert(static_cast<size_t>(ObjectType::_Last) <= 64, "ObjectType must fit into 64 bits");
+
+// Get bit representing type
+constexpr uint64_t typeBit(ObjectType type)
+{
+    return uint64_t{1} << static_cast<unsigned>(type);
+}
+
+// Get bits representing all types in [first, last]
+constexpr uint64_t typeBits(ObjectType first, ObjectType last)
+{
+    return (typeBit(last) << 1) - typeBit(first);
+}
+
+// Table of types derived from each type, including the type itself
+constexpr auto derivedTypes = [] {
+    std::array<uint64_t, static_cast<size_t>(ObjectType::_Last)> table{};
+
+    for (size_t i = 1; i < table.size(); ++i)
+    {
+        table[i] = typeBit(static_cast<ObjectType>(i));
+    }
+
+    auto at = [&](ObjectType type) -> uint64_t& { return table[static_cast<size_t>(type)]; };
+
+    at(ObjectType::Shape) |= typeBits(ObjectType::_ShapeFirst, ObjectType::_ShapeLast);
+    at(ObjectType::CellObject) |= at(ObjectType::Shape) | typeBit(ObjectType::Ref);
+    at(ObjectType::DrawingObject) |= at(ObjectType::CellObject) | typeBit(ObjectType::Layer) |
+                                     typeBit(ObjectType::Cell);
+    at(ObjectType::Property) |=
+        typeBits(ObjectType::BooleanProperty, ObjectType::LayerStringProperty);
+    at(ObjectType::Object) |= at(ObjectType::DrawingObject) | at(ObjectType::Property) |
+                              typeBit(ObjectType::Drawing) | typeBit(ObjectType::Tessellation);
+    return table;
+}();
+
+}  // namespace detail
+
+//! Check if type is equal to or derived from other
+//!
+//! Unlike isDerivedFrom(), this is evaluated inline by a single table lookup.
+constexpr bool isKindOf(ObjectType type, ObjectType baseType)
+{
+    return (detail::derivedTypes[static_cast<size_t>(baseType)] & detail::typeBit(type)) != 0;
+}
+
+static_assert(isKindOf(ObjectType::Polygon, ObjectType::Shape));
+static_assert(isKindOf(ObjectType::Ref, ObjectType::DrawingObject));
+static_assert(isKindOf(ObjectType::LayerRealProperty, ObjectType::Object));
+static_assert(isKindOf(ObjectType::Shape, ObjectType::CellObject));
+static_assert(!isKindOf(ObjectType::Ref, ObjectType::Shape));
+static_assert(!isKindOf(ObjectType::Cell, ObjectType::CellObject));
+static_assert(!isKindOf(ObjectType::Invalid, ObjectType::Object));
+
 }  // namespace lc::db
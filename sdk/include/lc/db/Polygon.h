@@ -126,6 +126,9 @@ public:
     bool isSelfIntersecting() const;
 
     //! Tests if vertices are self-intersecting
+    //!
+    //! See also geom::isSelfIntersecting() (lc/geom/SelfIntersection.h), an
+    //! O(n log n) sweep-line test suitable for large polygons.
     static bool isSelfIntersecting(const PointArray& vertices);
 
     //! Creates the tessellation data of this Polygon using the specified
@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Drawing.h"
+#include "Cell.h"
+#include "Ref.h"
+#include "Arc.h"
+#include "Polygon.h"
+#include "Polyline.h"
+#include "Donut.h"
+#include "Text.h"
+#include "Ellipse.h"
+#include "Nurbs.h"
+#include <type_traits>
+#include <utility>
+
+namespace lc::db {
+
+//! Helper to build a visitor from a set of lambdas
+//!
+//! Use like this:
+//!
+//!     dispatch(obj, Overloaded{
+//!                       [](Polygon* poly) { ... },
+//!                       [](Ref* ref) { ... },
+//!                       [](CellObject*) {},  // all other types
+//!                   });
+template <class... Ts>
+struct Overloaded : Ts...
+{
+    using Ts::operator()...;
+};
+
+template <class... Ts>
+Overloaded(Ts...) -> Overloaded<Ts...>;
+
+namespace detail {
+
+// Apply constness of From to To
+template <class From, class To>
+using CopyConst = std::conditional_t<std::is_const_v<From>, const To, To>;
+
+}  // namespace detail
+
+//------------------------------------------------------------------------------
+//! Invoke visitor with cell object cast to its dynamic type
+//!
+//! Unlike Cell::accept() and CellObject::accept(), which cross-cast the visitor
+//! using dynamic_cast for every object, the handler is selected at compile
+//! time by overload resolution, and the object type is determined by a single
+//! switch on dynamicType(). The visitor must be callable with a pointer to each
+//! of Ref, Arc, Polygon, Polyline, Donut, Text, Ellipse and Nurbs (handlers
+//! taking Shape* or CellObject* act as fallbacks).
+//!
+//! \param obj      Cell object (const or non-const)
+//! \param visitor  Callable, e.g. lambda or Overloaded
+//------------------------------------------------------------------------------
+template <class TObj, class F>
+    requires std::is_same_v<std::remove_const_t<TObj>, CellObject>
+void dispatch(TObj* obj, F&& visitor)
+{
+    using detail::CopyConst;
+
+    switch (obj->dynamicType())
+    {
+    case ObjectType::Ref: visitor(static_cast<CopyConst<TObj, Ref>*>(obj)); break;
+    case ObjectType::Arc: visitor(static_cast<CopyConst<TObj, Arc>*>(obj)); break;
+    case ObjectType::Polygon: visitor(static_cast<CopyConst<TObj, Polygon>*>(obj)); break;
+    case ObjectType::Polyline: visitor(static_cast<CopyConst<TObj, Polyline>*>(obj)); break;
+    case ObjectType::Donut: visitor(static_cast<CopyConst<TObj, Donut>*>(obj)); break;
+    case ObjectType::Text: visitor(static_cast<CopyConst<TObj, Text>*>(obj)); break;
+    case ObjectType::Ellipse: visitor(static_cast<CopyConst<TObj, Ellipse>*>(obj)); break;
+    case ObjectType::Nurbs: visitor(static_cast<CopyConst<TObj, Nurbs>*>(obj)); break;
+    default: UNREACHABLE;
+    }
+}
+
+//------------------------------------------------------------------------------
+//! Invoke visitor for each cell object of the given types in cell
+//!
+//! The cell objects are enumerated in a single pass, and each object is
+//! passed to the visitor cast to its dynamic type (see dispatch()); objects
+//! of other types are skipped. If a single type is given, the visitor is
+//! called with a pointer to that type.
+//!
+//! Use like this:
+//!
+//!     visitCellObjects<Polygon, Polyline>(cell, Overloaded{
+//!                                                   [](Polygon* poly) { ... },
+//!                                                   [](Polyline* pline) { ... },
+//!                                               });
+//!
+//! \tparam Ts      Cell object types to visit (Shape and CellObject visit
+//!                 all shapes respectively all cell objects)
+//! \param cell     Cell (const or non-const)
+//! \param visitor  Callable accepting a pointer to each of Ts
+//------------------------------------------------------------------------------
+template <class... Ts, class TCell, class F>
+    requires std::is_same_v<std::remove_const_t<TCell>, Cell>
+void visitCellObjects(TCell* cell, F&& visitor)
+{
+    using detail::CopyConst;
+
+    if constexpr (sizeof...(Ts) == 1)
+    {
+        auto visitType = [&]<class T>() {
+            for (auto obj : cell->template cellObjects<T>())
+            {
+                visitor(static_cast<CopyConst<TCell, T>*>(obj));
+            }
+        };
+
+        (visitType.template operator()<Ts>(), ...);
+    }
+    else
+    {
+        // only enumerate shapes if no references are visited
+        using Enumerated =
+            std::conditional_t<(std::is_base_of_v<Shape, Ts> && ...), Shape, CellObject>;
+
+        for (auto obj : cell->template cellObjects<Enumerated>())
+        {
+            dispatch(static_cast<CopyConst<TCell, CellObject>*>(obj), [&]<class U>(U* typedObj) {
+                if constexpr ((std::is_base_of_v<Ts, std::remove_const_t<U>> || ...))
+                    visitor(typedObj);
+            });
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//! Invoke visitor for each shape in cell
+//!
+//! See: visitCellObjects()
+//------------------------------------------------------------------------------
+template <class TCell, class F>
+    requires std::is_same_v<std::remove_const_t<TCell>, Cell>
+void visitShapes(TCell* cell, F&& visitor)
+{
+    visitCellObjects<Arc, Polygon, Polyline, Donut, Text, Ellipse, Nurbs>(
+        cell, std::forward<F>(visitor));
+}
+
+//------------------------------------------------------------------------------
+//! Invoke visitor for each cell of the drawing, and for each of its shapes
+//!
+//! For each cell, the visitor is first called with the cell, then with each
+//! shape of the cell (see visitShapes()). If the visitor returns a value
+//! convertible to bool when called with a cell, false skips the shapes of that
+//! cell.
+//!
+//! \param dwg      Drawing (const or non-const)
+//! \param visitor  Callable accepting a Cell pointer and a pointer to each
+//!                 shape type
+//------------------------------------------------------------------------------
+template <class TDrawing, class F>
+    requires std::is_same_v<std::remove_const_t<TDrawing>, Drawing>
+void visitCells(TDrawing* dwg, F&& visitor)
+{
+    for (auto cell : dwg->cells())
+    {
+        auto typedCell = static_cast<detail::CopyConst<TDrawing, Cell>*>(cell);
+
+        if constexpr (std::is_convertible_v<decltype(visitor(typedCell)), bool>)
+        {
+            if (!visitor(typedCell))
+                continue;
+        }
+        else
+        {
+            visitor(typedCell);
+        }
+
+        visitShapes(typedCell, visitor);
+    }
+}
+
+}  // namespace lc::db
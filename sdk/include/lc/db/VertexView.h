@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "dbdefs.h"
+#include "dbtypes.h"
+#include <iterator>
+#include <span>
+
+namespace lc::db {
+
+//! Read-only view on a vertex sequence, applying VertexMode filters lazily
+//!
+//! The view does not copy or own the vertices. It yields the same sequence
+//! as Polygon::vertices() or Polyline::vertices() would return for the given
+//! mode, but without allocating a filtered copy. If the number of filtered
+//! vertices is needed before iterating (see size()), a filtered copy into a
+//! reused buffer is usually cheaper.
+//!
+//! Use like this:
+//!
+//!     poly->vertices(buffer);  // raw vertices, buffer reused across calls
+//!     for (auto&& pt : VertexView(buffer, VertexMode::RemoveDuplicates))
+//!     {
+//!         ...
+//!     }
+class VertexView
+{
+public:
+    //! Forward iterator over filtered vertices
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Point*;
+        using reference = const Point&;
+
+        Iterator() = default;
+
+        reference operator*() const { return closing_ ? *view_->begin_ : *cur_; }
+        pointer operator->() const { return &**this; }
+
+        Iterator& operator++();
+
+        Iterator operator++(int)
+        {
+            Iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return cur_ == other.cur_ && closing_ == other.closing_;
+        }
+
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class VertexView;
+
+        Iterator(const VertexView* view, const Point* cur, bool closing)
+            : view_(view)
+            , cur_(cur)
+            , closing_(closing)
+        {}
+
+        const VertexView* view_ = nullptr;
+        const Point* cur_ = nullptr;  // current raw vertex
+        bool closing_ = false;  // true if positioned at appended closing vertex
+    };
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    //! Constructor
+    //!
+    //! \param raw      Raw vertices
+    //! \param mode     Filters to apply (see VertexMode)
+    //! \param closed   True if the vertices describe a closed contour (always
+    //!                 true for polygons); end filters only apply if closed.
+    explicit VertexView(std::span<const Point> raw,
+                        VertexMode mode = VertexMode::RawVertices,
+                        bool closed = true);
+
+    //! Get iterator representing first vertex
+    Iterator begin() const { return {this, begin_, false}; }
+
+    //! Get iterator pointing just beyond the last vertex
+    Iterator end() const { return {this, end_, false}; }
+
+    //! Test if view is empty
+    bool empty() const { return begin_ == end_; }
+
+    //! Count filtered vertices (linear in number of raw vertices)
+    size_t size() const;
+
+    //! Get raw vertices the view is based on
+    std::span<const Point> raw() const { return raw_; }
+
+private:
+    std::span<const Point> raw_;
+    const Point* begin_ = nullptr;
+    const Point* end_ = nullptr;  // end of raw range, after trimming duplicate end
+    bool removeDuplicates_ = false;
+    bool addClosing_ = false;  // append first vertex after end_
+};
+
+//------------------------------------------------------------------------------
+inline VertexView::VertexView(std::span<const Point> raw,
+                              VertexMode mode /* = VertexMode::RawVertices */,
+                              bool closed /* = true */)
+    : raw_(raw)
+    , begin_(raw.data())
+    , end_(raw.data() + raw.size())
+{
+    // two identical vertices are kept as is
+    removeDuplicates_ = (mode & VertexMode::RemoveDuplicates) == VertexMode::RemoveDuplicates &&
+                        !(raw.size() == 2 && raw[0] == raw[1]);
+
+    if (!closed || raw.empty())
+        return;
+
+    if ((mode & VertexMode::NoDuplicateEnd) == VertexMode::NoDuplicateEnd)
+    {
+        while (end_ - begin_ > 1 && *(end_ - 1) == *begin_)
+        {
+            --end_;
+        }
+    }
+
+    if ((mode & VertexMode::ForceDuplicateEnd) == VertexMode::ForceDuplicateEnd)
+    {
+        addClosing_ = *(end_ - 1) != *begin_;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline size_t VertexView::size() const
+{
+    return static_cast<size_t>(std::distance(begin(), end()));
+}
+
+//------------------------------------------------------------------------------
+inline VertexView::Iterator& VertexView::Iterator::operator++()
+{
+    if (closing_)
+    {
+        closing_ = false;
+        return *this;
+    }
+
+    const auto* prev = cur_++;
+
+    if (view_->removeDuplicates_)
+    {
+        while (cur_ != view_->end_ && *cur_ == *prev)
+        {
+            ++cur_;
+        }
+    }
+
+    if (cur_ == view_->end_ && view_->addClosing_)
+    {
+        closing_ = true;
+    }
+
+    return *this;
+}
+
+}  // namespace lc::db
@@ -21,6 +21,7 @@
 #include "Polyline.h"
 #include "Ref.h"
 #include "Text.h"
+#include "VertexView.h"
 #include "AutoPtr.h"
 #include "AutoLock.h"
 #include "IntegerProperty.h"
@@ -29,9 +30,9 @@
 #include "StringProperty.h"
 #include "FontManager.h"
 #include "RegionQuery.h"
-#include "RegionQuery.h"
 #include "IDrawingEventListener.h"
 #include "IObjectEventListener.h"
 #include "IRegionQuery.h"
 #include "Exception.h"
 #include "visitor.h"
+#include "StaticVisitor.h"
@@ -20,6 +20,10 @@ namespace lc::db {
 //      Additionally, for each entity type to visit, derive from
 //      IVisitor<EntityType> and implement the corresponding visit(EntityType&)
 //      and optionally leave(EntityType&) member function.
+//
+//      Each visited object cross-casts the visitor using dynamic_cast; for
+//      hot loops, prefer the statically dispatched dispatch(), visitShapes()
+//      and visitCells() functions (see StaticVisitor.h).
 //------------------------------------------------------------------------------
 class DBAPI NOVTABLE BaseVisitor
 {
@@ -0,0 +1,43 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "Point2d.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace lc::geom {
+
+//! Mix bits of 64-bit value (finalizer of splitmix64)
+constexpr uint64_t hashMix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+//! Combine hash value with another value
+constexpr uint64_t hashCombine(uint64_t seed, uint64_t value)
+{
+    return hashMix(seed + 0x9e3779b97f4a7c15ull + value);
+}
+
+//! Hash functor for points, e.g. for use with std::unordered_map
+struct PointHash
+{
+    template <typename T>
+    size_t operator()(const Point2dT<T>& pt) const
+    {
+        return hashCombine(hashMix(static_cast<uint64_t>(pt.x)), static_cast<uint64_t>(pt.y));
+    }
+};
+
+}  // namespace lc::geom
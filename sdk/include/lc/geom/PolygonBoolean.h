@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+#include "geomdefs.h"
+#include "PointArray.h"
+#include <vector>
+
+namespace lc::geom {
+
+//! Boolean operations on polygon sets
+enum class BooleanOp : unsigned char
+{
+    Union,  //!< Area covered by A or B
+    Intersection,  //!< Area covered by A and B
+    Difference,  //!< Area covered by A but not by B
+    Xor  //!< Area covered by either A or B, but not both
+};
+
+//! Set of polygon contours
+template <typename T>
+using PolygonSet = std::vector<PointArray<T>>;
+
+//! Compute Boolean operation on two polygon sets
+//!
+//! The operands are sets of closed contours (the closing vertex need not be
+//! repeated), which may overlap and self-intersect; their interior is defined
+//! by \c fillRule. The result is computed exactly on the integer grid: edges
+//! are split at their intersections, which are rounded to the nearest grid
+//! point, and the winding numbers of both operands are determined per edge
+//! in slabs between the vertices' x-coordinates.
+//!
+//! The result consists of non-overlapping contours with the interior on their
+//! left, i.e. outer contours are counter-clockwise and holes are clockwise.
+//! Collinear vertices are removed. Use linkHoles() to obtain polygons without
+//! holes.
+//!
+//! \warning Limitations:
+//!  - This is not a y-ordered sweep line with O((n + i) log n) running time
+//!    for i intersections. Both phases test each edge against the edges
+//!    overlapping it in x, so the running time is O(n * k) for n edges, where
+//!    k is the largest number of edges crossed by a vertical line. For
+//!    grid-like input, k grows with the square root of n (e.g. 40,000
+//!    abutting boxes take a few seconds), so large layers should be
+//!    partitioned into independent clusters first, as done by
+//!    db::booleanLayers().
+//!  - The full range of 64-bit coordinates is not supported. Coordinates must
+//!    not exceed +/-2^40, such that intersection points and the order of
+//!    edges along a vertical line, which involve products of three coordinate
+//!    differences, can be evaluated exactly with 128-bit integers.
+//!
+//! \param a         Operand A
+//! \param b         Operand B
+//! \param op        Operation
+//! \param fillRule  Fill rule of operands
+//! \return          Resulting contours
+//! \throw std::out_of_range    If a coordinate exceeds +/-2^40
+//! \throw std::runtime_error   If the intersections could not be resolved
+template <typename T>
+PolygonSet<T> booleanOp(const PolygonSet<T>& a,
+                        const PolygonSet<T>& b,
+                        BooleanOp op,
+                        FillRule fillRule = FillRule::NonZero);
+
+//! Merge overlapping polygons (union of all contours)
+//!
+//! See: booleanOp()
+template <typename T>
+PolygonSet<T> mergePolygons(const PolygonSet<T>& polygons, FillRule fillRule = FillRule::NonZero);
+
+//! Link holes to their enclosing outer contour
+//!
+//! Each hole of a result of booleanOp() is connected to the contour enclosing
+//! it by a pair of coincident bridge edges, from the hole's leftmost vertex
+//! to a visible vertex of the enclosing contour, such that every polygon of
+//! the result is a single, weakly simple contour.
+//!
+//! Holes are never returned as polygons of their own, as these would be
+//! filled rather than cut out.
+//!
+//! \param contours  Outer contours (counter-clockwise) and holes (clockwise)
+//! \return          Outer contours with holes linked
+//! \throw std::invalid_argument  If a hole isn't enclosed by an outer contour
+//! \throw std::runtime_error     If a hole could not be linked
+template <typename T>
+PolygonSet<T> linkHoles(const PolygonSet<T>& contours);
+
+}  // namespace lc::geom
+
+#include "PolygonBoolean.inl"
@@ -0,0 +1,859 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+
+#pragma once
+#include "Vector2d.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace lc::geom {
+namespace detail {
+
+//------------------------------------------------------------------------------
+// Edge of a Boolean operation, with end points in lexicographic order
+template <typename T>
+struct BooleanEdge
+{
+    Point2dT<T> p;  // lexicographically smaller end point
+    Point2dT<T> q;  // lexicographically larger end point
+    int windA = 0;  // winding contribution to operand A (positive if directed from p to q)
+    int windB = 0;  // winding contribution to operand B
+    int belowA = 0;  // winding number of A below (or left of vertical) edge
+    int belowB = 0;  // winding number of B below (or left of vertical) edge
+};
+
+//------------------------------------------------------------------------------
+// Nearest edge of a contour hit by a horizontal ray towards -x
+struct RayHit
+{
+    size_t edge = std::numeric_limits<size_t>::max();
+    coord_128 num = 0;  // x-coordinate of hit, as fraction num / den
+    coord_128 den = 1;
+};
+
+//------------------------------------------------------------------------------
+// Contour properties used by linkHoles()
+template <typename T>
+struct HoleLinkContour
+{
+    int orientation = 0;  // 1: outer contour, -1: hole
+    size_t leftmost = 0;  // index of leftmost (then lowest) vertex
+    T minX = 0, minY = 0, maxY = 0;
+    size_t owner = std::numeric_limits<size_t>::max();  // outer contour enclosing hole
+};
+
+//------------------------------------------------------------------------------
+// Largest coordinate magnitude supported by booleanOp()
+constexpr int64_t maxBooleanCoord = int64_t{1} << 40;
+
+//------------------------------------------------------------------------------
+// Check if all coordinates are within +/-maxBooleanCoord
+template <typename T>
+bool isInBooleanRange(const PolygonSet<T>& contours)
+{
+    return std::all_of(contours.begin(), contours.end(), [](auto&& contour) {
+        return std::all_of(contour.begin(), contour.end(), [](auto&& pt) {
+            return pt.x >= -maxBooleanCoord && pt.x <= maxBooleanCoord &&
+                   pt.y >= -maxBooleanCoord && pt.y <= maxBooleanCoord;
+        });
+    });
+}
+
+//------------------------------------------------------------------------------
+// Divide, rounding to nearest (ties away from zero)
+inline coord_128 roundedDivide(coord_128 num, coord_128 den)
+{
+    if (den < 0)
+    {
+        num = -num;
+        den = -den;
+    }
+
+    coord_128 quot = num / den;
+    coord_128 rem = num - quot * den;
+    if (2 * rem >= den)
+        ++quot;
+    else if (2 * rem <= -den)
+        --quot;
+
+    return quot;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void addBooleanEdges(const PolygonSet<T>& contours,
+                     bool operandB,
+                     std::vector<BooleanEdge<T>>& edges)
+{
+    for (auto&& contour : contours)
+    {
+        for (size_t i = 0, n = contour.size(); i < n; ++i)
+        {
+            const auto& u = contour[i];
+            const auto& v = contour[(i + 1) % n];
+            if (u == v)
+                continue;
+
+            const int wind = u < v ? 1 : -1;
+            BooleanEdge<T> edge{wind > 0 ? u : v, wind > 0 ? v : u};
+            (operandB ? edge.windB : edge.windA) = wind;
+            edges.push_back(edge);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Record split point, if in the interior of the edge
+template <typename T>
+void addSplitPoint(const BooleanEdge<T>& edge,
+                   const Point2dT<T>& pt,
+                   std::vector<Point2dT<T>>& splits)
+{
+    if (edge.p < pt && pt < edge.q)
+        splits.push_back(pt);
+}
+
+//------------------------------------------------------------------------------
+// Find points at which edges s and t must be split
+template <typename T>
+void intersectEdges(const BooleanEdge<T>& s,
+                    const BooleanEdge<T>& t,
+                    std::vector<Point2dT<T>>& splitsS,
+                    std::vector<Point2dT<T>>& splitsT)
+{
+    const int o1 = orientation(s.p, s.q, t.p);
+    const int o2 = orientation(s.p, s.q, t.q);
+    if (o1 == o2 && o1 != 0)
+        return;
+
+    const int o3 = orientation(t.p, t.q, s.p);
+    const int o4 = orientation(t.p, t.q, s.q);
+    if (o3 == o4 && o3 != 0)
+        return;
+
+    if (o1 == 0 && o2 == 0)
+    {
+        // collinear, split at end points within other edge
+        addSplitPoint(s, t.p, splitsS);
+        addSplitPoint(s, t.q, splitsS);
+        addSplitPoint(t, s.p, splitsT);
+        addSplitPoint(t, s.q, splitsT);
+        return;
+    }
+
+    if (o1 == 0)
+        addSplitPoint(s, t.p, splitsS);
+    if (o2 == 0)
+        addSplitPoint(s, t.q, splitsS);
+    if (o3 == 0)
+        addSplitPoint(t, s.p, splitsT);
+    if (o4 == 0)
+        addSplitPoint(t, s.q, splitsT);
+
+    if (o1 != 0 && o2 != 0 && o3 != 0 && o4 != 0)
+    {
+        // proper crossing, rounded to the nearest grid point
+        const auto d1 = s.q - s.p;
+        const auto d2 = t.q - t.p;
+        const auto w = t.p - s.p;
+        const coord_128 den =
+            static_cast<coord_128>(d1.x) * d2.y - static_cast<coord_128>(d1.y) * d2.x;
+        const coord_128 num =
+            static_cast<coord_128>(w.x) * d2.y - static_cast<coord_128>(w.y) * d2.x;
+
+        // both edges pass close to the rounded point, which may however lie
+        // slightly outside either edge; both are routed through it anyway,
+        // such that they don't cross anymore (snap rounding)
+        const Point2dT<T> pt(s.p.x + static_cast<T>(roundedDivide(num * d1.x, den)),
+                             s.p.y + static_cast<T>(roundedDivide(num * d1.y, den)));
+        if (pt != s.p && pt != s.q)
+            splitsS.push_back(pt);
+        if (pt != t.p && pt != t.q)
+            splitsT.push_back(pt);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Split edges at their mutual intersections and merge coincident edges
+//
+// Each edge is tested against all edges overlapping it in x and y, i.e. the
+// cost is proportional to the number of edges times the number of edges
+// crossing a vertical line. Returns false if the edges still intersect after
+// the maximum number of passes.
+template <typename T>
+bool splitEdges(std::vector<BooleanEdge<T>>& edges)
+{
+    // rounding intersection points moves edges slightly, which may create new
+    // intersections, so repeat until no more edges are split
+    constexpr int maxPasses = 16;
+
+    std::vector<std::vector<Point2dT<T>>> splits;
+    std::vector<size_t> order, active;
+    bool converged = false;
+
+    for (int pass = 0; pass <= maxPasses; ++pass)
+    {
+        splits.assign(edges.size(), {});
+        order.resize(edges.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::sort(order.begin(), order.end(),
+                  [&](size_t i, size_t j) { return edges[i].p.x < edges[j].p.x; });
+
+        // test each edge against the preceding edges overlapping it in x
+        active.clear();
+        for (auto i : order)
+        {
+            const auto& e = edges[i];
+            std::erase_if(active, [&](size_t j) { return edges[j].q.x < e.p.x; });
+
+            const T minY = std::min(e.p.y, e.q.y);
+            const T maxY = std::max(e.p.y, e.q.y);
+            for (auto j : active)
+            {
+                const auto& f = edges[j];
+                if (std::max(f.p.y, f.q.y) >= minY && std::min(f.p.y, f.q.y) <= maxY)
+                    intersectEdges(e, f, splits[i], splits[j]);
+            }
+
+            active.push_back(i);
+        }
+
+        converged =
+            std::all_of(splits.begin(), splits.end(), [](auto&& pts) { return pts.empty(); });
+        if (converged || pass == maxPasses)
+            break;
+
+        std::vector<BooleanEdge<T>> result;
+        result.reserve(edges.size());
+        for (size_t i = 0; i < edges.size(); ++i)
+        {
+            auto& pts = splits[i];
+            if (pts.empty())
+            {
+                result.push_back(edges[i]);
+                continue;
+            }
+
+            // order split points along the edge
+            const auto e = edges[i];
+            const auto d = e.q - e.p;
+            std::sort(pts.begin(), pts.end(), [&](auto&& a, auto&& b) {
+                const auto da = static_cast<coord_128>(a.x - e.p.x) * d.x +
+                                static_cast<coord_128>(a.y - e.p.y) * d.y;
+                const auto db = static_cast<coord_128>(b.x - e.p.x) * d.x +
+                                static_cast<coord_128>(b.y - e.p.y) * d.y;
+                return da != db ? da < db : a < b;
+            });
+            pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+            pts.insert(pts.begin(), e.p);
+            pts.push_back(e.q);
+
+            for (size_t k = 0; k + 1 < pts.size(); ++k)
+            {
+                const auto& u = pts[k];
+                const auto& v = pts[k + 1];
+                if (u == v)
+                    continue;
+
+                // rounded split points may reverse the direction of short pieces
+                if (u < v)
+                    result.push_back({u, v, e.windA, e.windB});
+                else
+                    result.push_back({v, u, -e.windA, -e.windB});
+            }
+        }
+
+        edges = std::move(result);
+    }
+
+    // merge coincident edges, dropping edges without net winding contribution
+    std::sort(edges.begin(), edges.end(), [](auto&& a, auto&& b) {
+        return a.p != b.p ? a.p < b.p : a.q < b.q;
+    });
+
+    size_t count = 0;
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        if (count > 0 && edges[count - 1].p == edges[i].p && edges[count - 1].q == edges[i].q)
+        {
+            edges[count - 1].windA += edges[i].windA;
+            edges[count - 1].windB += edges[i].windB;
+        }
+        else
+        {
+            edges[count++] = edges[i];
+        }
+    }
+
+    edges.resize(count);
+    std::erase_if(edges, [](auto&& e) { return e.windA == 0 && e.windB == 0; });
+    return converged;
+}
+
+//------------------------------------------------------------------------------
+// Compute winding numbers below each edge (left of vertical edges)
+//
+// The plane is divided into slabs between consecutive vertex x-coordinates.
+// As edges only intersect at vertices, the edges spanning a slab are totally
+// ordered by y, and the winding number below an edge is the sum of the
+// contributions of all edges below it. The windings of all edges spanning a
+// slab are accumulated for every slab.
+template <typename T>
+void computeWindings(std::vector<BooleanEdge<T>>& edges)
+{
+    if (edges.empty())
+        return;
+
+    std::vector<T> xs;
+    xs.reserve(2 * edges.size());
+    std::vector<size_t> sloped, vertical;
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        xs.push_back(edges[i].p.x);
+        xs.push_back(edges[i].q.x);
+        (edges[i].p.x == edges[i].q.x ? vertical : sloped).push_back(i);
+    }
+
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+    auto byX = [&](size_t i, size_t j) { return edges[i].p.x < edges[j].p.x; };
+    std::sort(sloped.begin(), sloped.end(), byX);
+    std::sort(vertical.begin(), vertical.end(), byX);
+
+    // compare y of sloped edges at x = x2 / 2
+    auto lessAt = [&](size_t i, size_t j, coord_128 x2) {
+        const auto& a = edges[i];
+        const auto& b = edges[j];
+        const coord_128 dxa = a.q.x - a.p.x;
+        const coord_128 dxb = b.q.x - b.p.x;
+        const coord_128 ya = 2 * a.p.y * dxa + (a.q.y - a.p.y) * (x2 - 2 * a.p.x);
+        const coord_128 yb = 2 * b.p.y * dxb + (b.q.y - b.p.y) * (x2 - 2 * b.p.x);
+        return ya * dxb < yb * dxa;
+    };
+
+    // check if sloped edge is below y = y2 / 2 at x
+    auto belowAt = [&](size_t i, T x, coord_128 y2) {
+        const auto& e = edges[i];
+        const coord_128 dx = e.q.x - e.p.x;
+        const coord_128 y = e.p.y * dx + (e.q.y - e.p.y) * static_cast<coord_128>(x - e.p.x);
+        return 2 * y < y2 * dx;
+    };
+
+    std::vector<size_t> active;
+    std::vector<int> windA, windB;
+    size_t nextSloped = 0;
+    size_t nextVertical = 0;
+
+    // nothing is left of the leftmost vertical edges
+    while (nextVertical < vertical.size() && edges[vertical[nextVertical]].p.x == xs.front())
+    {
+        ++nextVertical;
+    }
+
+    for (size_t i = 0; i + 1 < xs.size(); ++i)
+    {
+        const T x0 = xs[i];
+        const T x1 = xs[i + 1];
+        const coord_128 xMid2 = static_cast<coord_128>(x0) + x1;
+
+        std::erase_if(active, [&](size_t k) { return edges[k].q.x <= x0; });
+
+        for (; nextSloped < sloped.size() && edges[sloped[nextSloped]].p.x == x0; ++nextSloped)
+        {
+            const auto k = sloped[nextSloped];
+            auto it = std::lower_bound(active.begin(), active.end(), k,
+                                       [&](size_t a, size_t b) { return lessAt(a, b, xMid2); });
+            active.insert(it, k);
+        }
+
+        // accumulate windings bottom-up
+        windA.assign(1, 0);
+        windB.assign(1, 0);
+        for (auto k : active)
+        {
+            auto& e = edges[k];
+            e.belowA = windA.back();
+            e.belowB = windB.back();
+            windA.push_back(e.belowA + e.windA);
+            windB.push_back(e.belowB + e.windB);
+        }
+
+        // vertical edges at the right end of the slab see its windings to their left
+        for (; nextVertical < vertical.size() && edges[vertical[nextVertical]].p.x == x1;
+             ++nextVertical)
+        {
+            auto& e = edges[vertical[nextVertical]];
+            const coord_128 yMid2 = static_cast<coord_128>(e.p.y) + e.q.y;
+            auto it = std::partition_point(active.begin(), active.end(),
+                                           [&](size_t k) { return belowAt(k, x1, yMid2); });
+            e.belowA = windA[it - active.begin()];
+            e.belowB = windB[it - active.begin()];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+inline bool isInside(int winding, FillRule fillRule)
+{
+    return fillRule == FillRule::EvenOdd ? (winding & 1) != 0 : winding != 0;
+}
+
+//------------------------------------------------------------------------------
+inline bool applyBooleanOp(bool a, bool b, BooleanOp op)
+{
+    switch (op)
+    {
+    case BooleanOp::Union: return a || b;
+    case BooleanOp::Intersection: return a && b;
+    case BooleanOp::Difference: return a && !b;
+    case BooleanOp::Xor: return a != b;
+    default: return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Remove duplicate and collinear vertices (including zero-width spikes)
+template <typename T>
+void removeCollinearVertices(PointArray<T>& contour)
+{
+    PointArray<T> result;
+    result.reserve(contour.size());
+
+    for (auto&& pt : contour)
+    {
+        while (result.size() >= 2 && orientation(result[result.size() - 2], result.back(), pt) == 0)
+        {
+            result.pop_back();
+        }
+
+        if (result.empty() || result.back() != pt)
+            result.push_back(pt);
+    }
+
+    // close contour
+    bool changed = true;
+    while (changed && result.size() >= 3)
+    {
+        const size_t n = result.size();
+
+        if (result.front() == result.back() ||
+            orientation(result[n - 2], result[n - 1], result[0]) == 0)
+            result.pop_back();
+        else if (orientation(result[n - 1], result[0], result[1]) == 0)
+            result.erase(result.begin());
+        else
+            changed = false;
+    }
+
+    if (result.size() < 3)
+        result.clear();
+
+    contour.swap(result);
+}
+
+//------------------------------------------------------------------------------
+// Assemble directed boundary edges into contours
+//
+// At vertices shared by several contours, the outgoing edge turning most to
+// the left is taken, such that touching contours are separated.
+template <typename T>
+PolygonSet<T> assembleContours(std::vector<std::pair<Point2dT<T>, Point2dT<T>>>& edges)
+{
+    using Edge = std::pair<Point2dT<T>, Point2dT<T>>;
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    auto byStart = [](const Edge& a, const Edge& b) { return a.first < b.first; };
+    std::sort(edges.begin(), edges.end(), byStart);
+
+    PolygonSet<T> contours;
+    std::vector<bool> used(edges.size());
+
+    for (size_t start = 0; start < edges.size(); ++start)
+    {
+        if (used[start])
+            continue;
+
+        PointArray<T> contour;
+        bool closed = false;
+
+        for (size_t cur = start; !used[cur];)
+        {
+            used[cur] = true;
+            contour.push_back(edges[cur].first);
+
+            const auto& v = edges[cur].second;
+            const auto back = edges[cur].first - v;
+
+            // position of direction clockwise from back: (0, pi), pi, (pi, 2 pi), 2 pi
+            auto sector = [&](const Vector2dT<T>& d) {
+                int cross = exactSignOfCrossProduct(back, d);
+                if (cross != 0)
+                    return cross < 0 ? 0 : 2;
+
+                return signOfDotProduct(back, d) < 0 ? 1 : 3;
+            };
+
+            // first outgoing edge clockwise from the reversed incoming edge
+            size_t next = none;
+            auto [first, last] = std::equal_range(edges.begin(), edges.end(), Edge(v, v), byStart);
+            for (auto it = first; it != last; ++it)
+            {
+                const auto d = it->second - v;
+                if (next != none)
+                {
+                    const auto best = edges[next].second - v;
+                    const int s = sector(d);
+                    const int sBest = sector(best);
+                    if (s > sBest || (s == sBest && exactSignOfCrossProduct(best, d) <= 0))
+                        continue;
+                }
+
+                next = it - edges.begin();
+            }
+
+            if (next == start)
+                closed = true;
+            else if (next != none)
+                cur = next;
+        }
+
+        if (!closed)
+            continue;
+
+        removeCollinearVertices(contour);
+        if (!contour.empty())
+            contours.push_back(std::move(contour));
+    }
+
+    return contours;
+}
+
+//------------------------------------------------------------------------------
+// Check if the direction from ring vertex k to pt points into the interior of
+// the ring (interior on the left)
+template <typename T>
+bool isLocallyInside(const PointArray<T>& ring, size_t k, const Point2dT<T>& pt)
+{
+    const size_t n = ring.size();
+    const auto& prev = ring[(k + n - 1) % n];
+    const auto& p = ring[k];
+    const auto& next = ring[(k + 1) % n];
+
+    if (orientation(prev, p, next) >= 0)
+        return orientation(p, next, pt) >= 0 && orientation(p, pt, prev) >= 0;
+
+    return orientation(p, prev, pt) <= 0 || orientation(p, pt, next) <= 0;
+}
+
+//------------------------------------------------------------------------------
+// Find nearest edge or vertex of contour hit by horizontal ray from pt towards
+// -x, such that the contour's interior (its left side) is towards pt
+//
+// Vertices are only hit if their interior angle contains the direction
+// towards pt, which selects the right contour or the right visit of a vertex
+// shared by several contours or visited repeatedly. At pt itself, the
+// interior must contain the direction towards -x. A vertex hit is reported
+// as a hit of the edge starting at the vertex.
+template <typename T>
+RayHit rayHit(const PointArray<T>& contour, const Point2dT<T>& pt)
+{
+    RayHit hit;
+    const Point2dT<T> away(pt.x - 1, pt.y);
+
+    auto record = [&](size_t i, coord_128 num, coord_128 den) {
+        if (hit.edge == RayHit{}.edge || num * hit.den > hit.num * den)
+            hit = {i, num, den};
+    };
+
+    for (size_t i = 0, n = contour.size(); i < n; ++i)
+    {
+        const auto& a = contour[i];
+        const auto& b = contour[(i + 1) % n];
+
+        if (a.y == pt.y && a.x <= pt.x)
+        {
+            if (isLocallyInside(contour, i, a == pt ? away : pt))
+                record(i, a.x, 1);
+        }
+
+        if ((a.y < pt.y && b.y > pt.y) || (a.y > pt.y && b.y < pt.y))
+        {
+            coord_128 den = b.y - a.y;
+            coord_128 num = static_cast<coord_128>(a.x) * den +
+                            static_cast<coord_128>(pt.y - a.y) * (b.x - a.x);
+            if (den < 0)
+            {
+                num = -num;
+                den = -den;
+            }
+
+            const auto x = static_cast<coord_128>(pt.x) * den;
+            if (num < x || (num == x && b.y > a.y))
+                record(i, num, den);
+        }
+    }
+
+    return hit;
+}
+
+//------------------------------------------------------------------------------
+// Link hole to ring by a bridge from the hole's vertex start (its leftmost
+// vertex) to a visible vertex of the ring
+template <typename T>
+bool bridgeHole(PointArray<T>& ring, const PointArray<T>& hole, size_t start)
+{
+    const auto& h = hole[start];
+    const auto hit = rayHit(ring, h);
+    if (hit.edge == RayHit{}.edge)
+        return false;
+
+    const size_t n = ring.size();
+    const size_t ia = hit.edge;
+    const size_t ib = (hit.edge + 1) % n;
+    size_t m;
+
+    if (hit.num == static_cast<coord_128>(h.x) * hit.den)
+    {
+        // hole touches ring
+        if (ring[ia] == h)
+            m = ia;
+        else
+        {
+            ring.insert(ring.begin() + ia + 1, h);
+            m = ia + 1;
+        }
+    }
+    else if (ring[ia].y == h.y)
+    {
+        // vertex hit by ray
+        m = ia;
+    }
+    else
+    {
+        // the end point of the hit edge is visible, unless a vertex of the
+        // ring lies within the triangle formed by the hole vertex, the hit
+        // point and the end point; then, take the one closest in angle to the ray
+        m = ring[ia].x > ring[ib].x ? ia : ib;
+        if (ring[m].x > h.x)
+            m = m == ia ? ib : ia;
+
+        const auto a = ring[ia];
+        const auto b = ring[ib];
+        const auto end = ring[m];
+        const auto other = m == ia ? b : a;
+        const int sideEdge = orientation(a, b, h);
+        const int sideBridge = orientation(h, end, other);
+        const bool above = end.y > h.y;
+
+        auto tanLess = [&](const Point2dT<T>& p, const Point2dT<T>& q) {
+            // |p.y - h.y| / (h.x - p.x) < |q.y - h.y| / (h.x - q.x)
+            const coord_128 dyp = p.y > h.y ? p.y - h.y : h.y - p.y;
+            const coord_128 dyq = q.y > h.y ? q.y - h.y : h.y - q.y;
+            return dyp * (h.x - q.x) < dyq * (h.x - p.x);
+        };
+
+        for (size_t k = 0; k < n; ++k)
+        {
+            const auto& p = ring[k];
+            if (k == m || p.x >= h.x || (above ? p.y < h.y : p.y > h.y) ||
+                orientation(a, b, p) * sideEdge < 0 || orientation(h, end, p) * sideBridge < 0)
+                continue;
+
+            const auto& best = ring[m];
+            if ((tanLess(p, best) || (!tanLess(best, p) && p.x > best.x)) &&
+                isLocallyInside(ring, k, h))
+                m = k;
+        }
+    }
+
+    PointArray<T> merged;
+    merged.reserve(ring.size() + hole.size() + 2);
+    merged.insert(merged.end(), ring.begin(), ring.begin() + m + 1);
+    for (size_t i = 0; i <= hole.size(); ++i)
+    {
+        merged.push_back(hole[(start + i) % hole.size()]);
+    }
+
+    merged.insert(merged.end(), ring.begin() + m, ring.end());
+    merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+    ring.swap(merged);
+    return true;
+}
+
+}  // namespace detail
+
+//------------------------------------------------------------------------------
+template <typename T>
+PolygonSet<T> booleanOp(const PolygonSet<T>& a,
+                        const PolygonSet<T>& b,
+                        BooleanOp op,
+                        FillRule fillRule /* = FillRule::NonZero */)
+{
+    if (!detail::isInBooleanRange(a) || !detail::isInBooleanRange(b))
+        throw std::out_of_range("Coordinates exceed range of Boolean operation");
+
+    std::vector<detail::BooleanEdge<T>> edges;
+    detail::addBooleanEdges(a, false, edges);
+    detail::addBooleanEdges(b, true, edges);
+    if (!detail::splitEdges(edges))
+        throw std::runtime_error("Boolean operation did not converge");
+
+    detail::computeWindings(edges);
+
+    // keep edges separating inside from outside, directed with the inside on their left
+    std::vector<std::pair<Point2dT<T>, Point2dT<T>>> boundary;
+    for (auto&& e : edges)
+    {
+        const bool vertical = e.p.x == e.q.x;
+        const int rightA = vertical ? e.belowA - e.windA : e.belowA;
+        const int rightB = vertical ? e.belowB - e.windB : e.belowB;
+        const int leftA = rightA + e.windA;
+        const int leftB = rightB + e.windB;
+
+        const bool insideLeft = detail::applyBooleanOp(detail::isInside(leftA, fillRule),
+                                                       detail::isInside(leftB, fillRule), op);
+        const bool insideRight = detail::applyBooleanOp(detail::isInside(rightA, fillRule),
+                                                        detail::isInside(rightB, fillRule), op);
+
+        if (insideLeft && !insideRight)
+            boundary.emplace_back(e.p, e.q);
+        else if (insideRight && !insideLeft)
+            boundary.emplace_back(e.q, e.p);
+    }
+
+    return detail::assembleContours(boundary);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+PolygonSet<T> mergePolygons(const PolygonSet<T>& polygons,
+                            FillRule fillRule /* = FillRule::NonZero */)
+{
+    return booleanOp(polygons, PolygonSet<T>(), BooleanOp::Union, fillRule);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+PolygonSet<T> linkHoles(const PolygonSet<T>& contours)
+{
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    std::vector<detail::HoleLinkContour<T>> info(contours.size());
+    std::vector<size_t> holes;
+
+    for (size_t i = 0; i < contours.size(); ++i)
+    {
+        const auto& c = contours[i];
+        auto& ci = info[i];
+        if (c.size() < 3)
+            continue;
+
+        coord_128 area2 = 0;
+        for (size_t k = 0, n = c.size(); k < n; ++k)
+        {
+            const auto& u = c[k];
+            const auto& v = c[(k + 1) % n];
+            area2 += static_cast<coord_128>(u.x) * v.y - static_cast<coord_128>(v.x) * u.y;
+
+            if (u < c[ci.leftmost])
+                ci.leftmost = k;
+        }
+
+        ci.orientation = area2 > 0 ? 1 : (area2 < 0 ? -1 : 0);
+        ci.minX = c[ci.leftmost].x;
+        ci.minY = ci.maxY = c[0].y;
+        for (auto&& pt : c)
+        {
+            ci.minY = std::min(ci.minY, pt.y);
+            ci.maxY = std::max(ci.maxY, pt.y);
+        }
+
+        if (ci.orientation > 0)
+            ci.owner = i;
+        else if (ci.orientation < 0)
+            holes.push_back(i);
+    }
+
+    // the contour hit first by a ray from the leftmost vertex of a hole towards
+    // -x is either the enclosing outer contour, or another hole further left
+    // within the same outer contour
+    std::sort(holes.begin(), holes.end(), [&](size_t i, size_t j) {
+        return contours[i][info[i].leftmost] < contours[j][info[j].leftmost];
+    });
+
+    for (auto h : holes)
+    {
+        const auto& pt = contours[h][info[h].leftmost];
+        detail::RayHit best;
+        size_t bestContour = none;
+
+        for (size_t i = 0; i < contours.size(); ++i)
+        {
+            const auto& ci = info[i];
+            if (i == h || ci.orientation == 0 || ci.minX > pt.x || ci.minY > pt.y || ci.maxY < pt.y)
+                continue;
+
+            const auto hit = detail::rayHit(contours[i], pt);
+            if (hit.edge == detail::RayHit{}.edge)
+                continue;
+
+            const auto lhs = hit.num * best.den;
+            const auto rhs = best.num * hit.den;
+            if (bestContour == none || lhs > rhs ||
+                (lhs == rhs && info[bestContour].owner == none && ci.owner != none))
+            {
+                best = hit;
+                bestContour = i;
+            }
+        }
+
+        if (bestContour != none)
+            info[h].owner = info[bestContour].owner;
+    }
+
+    // a hole emitted as polygon of its own would be filled, so reject input
+    // with holes lacking an enclosing contour
+    std::vector<std::vector<size_t>> holesOf(contours.size());
+    for (auto h : holes)
+    {
+        if (info[h].owner == none)
+            throw std::invalid_argument("Hole without enclosing contour");
+
+        holesOf[info[h].owner].push_back(h);
+    }
+
+    PolygonSet<T> result;
+    for (size_t i = 0; i < contours.size(); ++i)
+    {
+        if (info[i].orientation <= 0)
+            continue;
+
+        // link holes from left to right, such that holes further right may
+        // be bridged to holes already linked
+        PointArray<T> ring = contours[i];
+        for (auto h : holesOf[i])
+        {
+            if (!detail::bridgeHole(ring, contours[h], info[h].leftmost))
+                throw std::runtime_error("Hole could not be linked to enclosing contour");
+        }
+
+        ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+        if (ring.size() > 1 && ring.front() == ring.back())
+            ring.pop_back();
+
+        result.push_back(std::move(ring));
+    }
+
+    return result;
+}
+
+}  // namespace lc::geom
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+// Copyright (C) Gehriger Engineering, Inc.
+//
+// This material is the intellectual property of Gehriger Engineering, Inc. and
+// may not be redistributed, modified, copied in any way, by any means without
+// written permission of Gehriger Engineering.
+//------------------------------------------------------------------------------
+#pragma once
+#include "geomdefs.h"
+#include "PointArray.h"
+#include "Vector2d.h"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <vector>
+
+namespace lc::geom {
+
+//! Test if a closed contour is self-intersecting
+//!
+//! The contour is self-intersecting if any two non-adjacent edges cross or
+//! touch, if a vertex is visited more than once, or if two adjacent edges
+//! overlap (i.e. the contour backtracks). Repeated consecutive vertices and
+//! the closing vertex are ignored.
+//!
+//! Uses a Shamos-Hoey sweep line, requiring O(n log n) time, with exact
+//! integer predicates. Coordinates must not exceed +/-2^62.
+//!
+//! \param vertices  Contour vertices
+//! \return          True if self-intersecting
+template <typename T>
+bool isSelfIntersecting(const PointArray<T>& vertices);
+
+namespace detail {
+
+// Edge of a contour, with end points in lexicographic order
+template <typename T>
+struct SweepEdge
+{
+    Point2dT<T> p;  // lexicographically smaller end point
+    Point2dT<T> q;  // lexicographically larger end point
+};
+
+//------------------------------------------------------------------------------
+// Test if point c, collinear with edge e, lies on e
+template <typename T>
+bool isOnEdge(const SweepEdge<T>& e, const Point2dT<T>& c)
+{
+    return !(c < e.p) && !(e.q < c);
+}
+
+//------------------------------------------------------------------------------
+// Test if two edges cross or touch
+template <typename T>
+bool edgesIntersect(const SweepEdge<T>& s, const SweepEdge<T>& t)
+{
+    const int o1 = orientation(s.p, s.q, t.p);
+    const int o2 = orientation(s.p, s.q, t.q);
+    const int o3 = orientation(t.p, t.q, s.p);
+    const int o4 = orientation(t.p, t.q, s.q);
+
+    if (o1 * o2 < 0 && o3 * o4 < 0)
+        return true;
+
+    return (o1 == 0 && isOnEdge(s, t.p)) || (o2 == 0 && isOnEdge(s, t.q)) ||
+           (o3 == 0 && isOnEdge(t, s.p)) || (o4 == 0 && isOnEdge(t, s.q));
+}
+
+//------------------------------------------------------------------------------
+// Side of edge b relative to edge a, where b starts at or after a's start
+// point (1: above, -1: below, 0: collinear)
+template <typename T>
+int sideOfEdge(const SweepEdge<T>& a, const SweepEdge<T>& b)
+{
+    if (a.p != b.p)
+    {
+        if (int o = orientation(a.p, a.q, b.p))
+            return o;
+    }
+
+    return orientation(a.p, a.q, b.q);
+}
+
+}  // namespace detail
+
+//------------------------------------------------------------------------------
+template <typename T>
+bool isSelfIntersecting(const PointArray<T>& vertices)
+{
+    using Edge = detail::SweepEdge<T>;
+
+    PointArray<T> v;
+    v.reserve(vertices.size());
+    for (auto&& pt : vertices)
+    {
+        if (v.empty() || v.back() != pt)
+            v.push_back(pt);
+    }
+
+    while (v.size() > 1 && v.back() == v.front())
+        v.pop_back();
+
+    const size_t n = v.size();
+    if (n < 3)
+        return false;
+
+    // a vertex visited twice, or an edge folding back onto its predecessor
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return v[i] < v[j]; });
+
+    for (size_t k = 1; k < n; ++k)
+    {
+        if (v[order[k - 1]] == v[order[k]])
+            return true;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto& u = v[(i + n - 1) % n];
+        const auto& w = v[(i + 1) % n];
+        if (orientation(u, v[i], w) == 0 && (u < v[i]) == (w < v[i]))
+            return true;
+    }
+
+    // edge i connects vertex i and i + 1; since vertices are unique, only
+    // adjacent edges share an end point
+    std::vector<Edge> edges(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto& a = v[i];
+        const auto& b = v[(i + 1) % n];
+        edges[i] = a < b ? Edge{a, b} : Edge{b, a};
+    }
+
+    auto isAdjacent = [n](size_t i, size_t j) {
+        return (i + 1) % n == j || (j + 1) % n == i;
+    };
+
+    // order of edges crossing the sweep line, which is consistent as long as
+    // no two edges intersect
+    auto below = [&](size_t i, size_t j) {
+        if (i == j)
+            return false;
+
+        const auto& a = edges[i];
+        const auto& b = edges[j];
+        if (b.p < a.p)
+        {
+            const int side = detail::sideOfEdge(b, a);
+            return side != 0 ? side < 0 : i < j;
+        }
+
+        const int side = detail::sideOfEdge(a, b);
+        return side != 0 ? side > 0 : i < j;
+    };
+
+    std::set<size_t, decltype(below)> status(below);
+    std::vector<typename std::set<size_t, decltype(below)>::iterator> position(n);
+
+    auto intersect = [&](size_t i, size_t j) {
+        return !isAdjacent(i, j) && detail::edgesIntersect(edges[i], edges[j]);
+    };
+
+    // sweep over the vertices, inserting the edges starting at a vertex
+    // before removing those ending there
+    for (auto i : order)
+    {
+        const size_t incident[] = {(i + n - 1) % n, i};
+
+        for (auto e : incident)
+        {
+            if (edges[e].p != v[i])
+                continue;
+
+            auto it = status.insert(e).first;
+            position[e] = it;
+
+            if (it != status.begin() && intersect(*std::prev(it), e))
+                return true;
+
+            if (std::next(it) != status.end() && intersect(e, *std::next(it)))
+                return true;
+        }
+
+        for (auto e : incident)
+        {
+            if (edges[e].q != v[i])
+                continue;
+
+            auto it = status.erase(position[e]);
+            if (it != status.begin() && it != status.end() && intersect(*std::prev(it), *it))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+}  // namespace lc::geom
@@ -9,6 +9,7 @@
 #include "geom.h"
 #include "Angle.h"
 #include "Tolerance.h"
+#include <lc/util/lcassert.h>
 
 #if !defined(__GNUC__) && !defined(__clang__)
 #include <boost/multiprecision/cpp_int.hpp>
@@ -627,6 +628,42 @@ constexpr int signOfDotProduct(const Vector2dT<T>& lhs, const Vector2dT<T>& rhs)
         return -1;
 }
 
+// Calculate the exact sign of the cross product using 128-bit integer arithmetic
+template <typename T>
+constexpr int exactSignOfCrossProduct(const Vector2dT<T>& lhs, const Vector2dT<T>& rhs)
+{
+    auto p1 = static_cast<coord_128>(lhs.x) * static_cast<coord_128>(rhs.y);
+    auto p2 = static_cast<coord_128>(lhs.y) * static_cast<coord_128>(rhs.x);
+
+    if (p1 > p2)
+        return 1;
+    else if (p1 == p2)
+        return 0;
+    else
+        return -1;
+}
+
+// Calculate the exact orientation of point c relative to the line from a to b
+// (1: left, 0: collinear, -1: right)
+//
+// Coordinates must not exceed +/-2^62. Differences are taken in 128 bits, as
+// they may exceed the range of T, and their products then fit into 127 bits.
+template <typename T>
+int orientation(const Point2dT<T>& a, const Point2dT<T>& b, const Point2dT<T>& c)
+{
+    constexpr coord_128 maxCoord = coord_128{1} << 62;
+    [[maybe_unused]] auto inRange = [](const Point2dT<T>& pt) {
+        const auto x = static_cast<coord_128>(pt.x);
+        const auto y = static_cast<coord_128>(pt.y);
+        return x >= -maxCoord && x <= maxCoord && y >= -maxCoord && y <= maxCoord;
+    };
+    ASSERT(inRange(a) && inRange(b) && inRange(c));
+
+    const auto p1 = (static_cast<coord_128>(b.x) - a.x) * (static_cast<coord_128>(c.y) - a.y);
+    const auto p2 = (static_cast<coord_128>(b.y) - a.y) * (static_cast<coord_128>(c.x) - a.x);
+    return (p1 > p2) - (p1 < p2);
+}
+
 template <typename T>
 constexpr int signOfCrossProduct(const Vector2dT<T>& lhs, const Vector2dT<T>& rhs)
 {